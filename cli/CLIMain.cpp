@@ -4,6 +4,10 @@
 #include "CsvParser.h"
 #include "OptionParser.h"
 #include "../include/TestStatistics.h"
+#include "../src/ChunkedCDF.h"
+#include "../src/ZetaCache.h"
+#include "../src/ZetaSurrogate.h"
+#include "../src/ZetaTable.h"
 using namespace std;
 
 /****************************
@@ -33,7 +37,7 @@ struct Arg : public option::Arg
 
 enum optionIndex
 {
-    UNKNOWN, DATA, BOOTSTRAP_REPLICAS, ALPHA_PRECISION, MODEL_TYPE, FULL_PARAMETRIC, X_PARAMETER, SINGLE_THREAD, HELP
+    UNKNOWN, DATA, BOOTSTRAP_REPLICAS, ALPHA_PRECISION, ALPHA_ESTIMATOR, MODEL_TYPE, GLOBAL_MINIMUM, MIN_TAIL_SIZE, FULL_PARAMETRIC, X_PARAMETER, SINGLE_THREAD, ZETA_TABLE, ZETA_SURROGATE, CDF_BUDGET, HELP
 };
 
 const option::Descriptor usage[] =
@@ -42,10 +46,16 @@ const option::Descriptor usage[] =
         {DATA,                0, "d", "data",            Arg::Required, "  -d <data_to_test>, \t--data=<data_to_test>  \tSample data as a list of comma-separated integers." },
         {BOOTSTRAP_REPLICAS,  0, "r", "replicas",        Arg::Required, "  -r <number_of_replicas>, \t--replicas=<number_of_replicas>  \tNumber of bootstrap replicas. Default is 2000." },
         {ALPHA_PRECISION,     0, "a", "alpha_precision", Arg::Required, "  -a <least_significant>, \t--alpha_precision=<least_significant>  \tPrecision for alpha estimation. Default is 0.01." },
-        {X_PARAMETER,         0, "x", "x_parameter",     Arg::Required, "  -x <value>, \t--x_parameter=<value>  \tKnown value of the x parameter if there is any." },
-        {MODEL_TYPE,          0, "m", "model_type",      Arg::Required, "  -m <type>, \t--model_type=<type>  \tType of model. Can be LeftBounded or RightBounded. Default is LeftBounded." },
+        {ALPHA_ESTIMATOR,     0, "e", "alpha_estimator", Arg::Required, "  -e <method>, \t--alpha_estimator=<method>  \tMethod for alpha estimation. Can be Grid, Brent or Newton. Default is Grid." },
+        {X_PARAMETER,         0, "x", "x_parameter",     Arg::Required, "  -x <value>, \t--x_parameter=<value>  \tKnown value of the x parameter if there is any. Not used by DoublyBounded models." },
+        {MODEL_TYPE,          0, "m", "model_type",      Arg::Required, "  -m <type>, \t--model_type=<type>  \tType of model. Can be LeftBounded, RightBounded or DoublyBounded. Default is LeftBounded." },
+        {GLOBAL_MINIMUM,      0, "g", "global_minimum",  Arg::None,     "  -g, \t--global_minimum  \tEstimate xMin at the global minimum of the KS statistic. Default is the first local minimum." },
+        {MIN_TAIL_SIZE,       0, "t", "min_tail_size",   Arg::Required, "  -t <size>, \t--min_tail_size=<size>  \tMinimum number of observations in the tail of an xMin candidate. Default is 1." },
         {FULL_PARAMETRIC,     0, "f", "full_parametric", Arg::None,     "  -f, \t--full_parametric  \tWhether to bootstrap using a full parametric approach. Default is semi-parametric." },
-        {SINGLE_THREAD,       0, "s", "single_thread",   Arg::None,     "  -s, \t--single_thread  \tUse only one thread for the boot-strapping." },
+        {SINGLE_THREAD,       0, "s", "single_thread",   Arg::None,     "  -s, \t--single_thread  \tUse only one thread for the fit and the boot-strapping." },
+        {ZETA_TABLE,          0, "z", "zeta_table",      Arg::Required, "  -z <file>, \t--zeta_table=<file>  \tPrecomputed zeta table shared by concurrent runs. It is generated at that path if it does not exist." },
+        {ZETA_SURROGATE,      0, "c", "zeta_surrogate",  Arg::None,     "  -c, \t--zeta_surrogate  \tEstimate alpha of left bounded models with Chebyshev approximations of ln zeta(alpha, xMin), accurate to 1e-12." },
+        {CDF_BUDGET,          0, "b", "cdf_budget",      Arg::Required, "  -b <MiB>, \t--cdf_budget=<MiB>  \tMemory budget shared by all CDF tables. Values past it are evaluated directly. Default is 64." },
         {HELP,                0, "",  "help",            Arg::None,     "  \t--help  \tShow instructions." },
         {0,                   0, 0,   0,                 0,             0}
 };
@@ -55,7 +65,11 @@ int main(int argc, char* argv[])
     vector<int> data;
     int bootstrapReplicas = 2000;
     int xParameter = -1;
+    int smallestInterval = 20;
+    int minTailSize = 1;
     double alphaPrecision = 0.01;
+    AlphaEstimator alphaEstimator = AlphaEstimator::Grid;
+    LowerBoundSearch lowerBoundSearch = LowerBoundSearch::FirstLocalMinimum;
     RuntimeMode runtimeMode = RuntimeMode::MultiThread;
     SyntheticGeneratorMode syntheticGeneratorMode = SyntheticGeneratorMode::SemiParametric;
     DistributionType distributionType = DistributionType::LeftBounded;
@@ -93,11 +107,35 @@ int main(int argc, char* argv[])
             case ALPHA_PRECISION:
                 alphaPrecision = stod(opt.arg);
                 break;
+            case ALPHA_ESTIMATOR:
+                if (string(opt.arg) == "Brent")
+                    alphaEstimator = AlphaEstimator::Brent;
+                else if (string(opt.arg) == "Newton")
+                    alphaEstimator = AlphaEstimator::Newton;
+                else
+                    alphaEstimator = AlphaEstimator::Grid;
+                break;
             case X_PARAMETER:
                 xParameter = stoi(opt.arg);
                 break;
             case MODEL_TYPE:
-                distributionType = (string(opt.arg) == "RightBounded") ? DistributionType::RightBounded : DistributionType::LeftBounded;
+                if (string(opt.arg) == "RightBounded")
+                    distributionType = DistributionType::RightBounded;
+                else if (string(opt.arg) == "DoublyBounded")
+                    distributionType = DistributionType::DoublyBounded;
+                else
+                    distributionType = DistributionType::LeftBounded;
+                break;
+            case GLOBAL_MINIMUM:
+                lowerBoundSearch = LowerBoundSearch::GlobalMinimum;
+                break;
+            case MIN_TAIL_SIZE:
+                minTailSize = stoi(opt.arg);
+                if (minTailSize < 1)
+                {
+                    cout << "The minimum tail size must be at least 1\n";
+                    return 1;
+                }
                 break;
             case SINGLE_THREAD:
                 runtimeMode = RuntimeMode::SingleThread;
@@ -105,18 +143,43 @@ int main(int argc, char* argv[])
             case FULL_PARAMETRIC:
                 syntheticGeneratorMode = SyntheticGeneratorMode::FullParametric;
                 break;
+            case ZETA_TABLE:
+                if (!use_zeta_table(opt.arg))
+                    cout << "Could not open or generate the zeta table " << opt.arg << "\n";
+                break;
+            case ZETA_SURROGATE:
+                use_zeta_surrogates();
+                break;
+            case CDF_BUDGET:
+                set_cdf_memory_budget((size_t) stoul(opt.arg) << 20);
+                break;
             default:
                 break;
         }
     }
 
+    if (minTailSize > (int) data.size())
+    {
+        cout << "The minimum tail size can not exceed the sample size of " << data.size() << "\n";
+        return 1;
+    }
+
     chrono::steady_clock::time_point beginTime, endTime; // Used for benchmark.
     DiscretePowerLawDistribution* model;
 
-    if (xParameter == -1)
-        model = new DiscretePowerLawDistribution(data, alphaPrecision, distributionType);
+    if (xParameter == -1 || distributionType == DistributionType::DoublyBounded)
+        model = new DiscretePowerLawDistribution(data, alphaPrecision, distributionType, smallestInterval, alphaEstimator,
+                                                 runtimeMode, lowerBoundSearch, minTailSize);
     else
-        model = new DiscretePowerLawDistribution(data, xParameter, alphaPrecision, distributionType);
+        model = new DiscretePowerLawDistribution(data, xParameter, alphaPrecision, distributionType, alphaEstimator);
+
+    if (model->GetState() != DistributionState::Valid)
+    {
+        cout << "Could not fit the model: " << ((model->GetState() == DistributionState::NoInput) ?
+                "no sample data" : "the parameters are not valid for the sample") << endl;
+        delete model;
+        return 1;
+    }
 
     cout << "Fitted model:" << endl;
     cout << "Type: " << model->GetDistributionTypeStr() << endl;
@@ -126,6 +189,11 @@ int main(int argc, char* argv[])
         cout << "xMin: " << model->GetXMin() << endl;
     else if (model->GetDistributionType() == DistributionType::RightBounded)
         cout << "xMax: " << model->GetXMax() << endl;
+    else if (model->GetDistributionType() == DistributionType::DoublyBounded)
+    {
+        cout << "xMin: " << model->GetXMin() << endl;
+        cout << "xMax: " << model->GetXMax() << endl;
+    }
 
     cout << "Fit KS statistic: " << model->GetKSStatistic() << endl;
     cout << "Log-likelihood: " << model->GetLogLikelihood(data) << endl;
@@ -138,6 +206,20 @@ int main(int argc, char* argv[])
     auto timePerReplica = chrono::duration_cast<chrono::microseconds>(endTime - beginTime).count();
     cout << "Benchmark: " << timePerReplica / bootstrapReplicas << " [µs] per replica" << endl;
 
+    const HurwitzZetaCache::Statistics zetaCache = shared_zeta_cache().GetStatistics();
+    const auto zetaLookups = (double) (zetaCache.hits + zetaCache.misses);
+    cout << "Zeta cache: " << zetaCache.hits << " hits, " << zetaCache.misses << " misses";
+    if (zetaLookups > 0)
+        cout << " (" << 100.0 * (double) zetaCache.hits / zetaLookups << "% reuse)";
+    cout << endl;
+
+    if (const LogZetaSurrogateStore* surrogates = shared_zeta_surrogates())
+    {
+        const LogZetaSurrogateStore::Statistics statistics = surrogates->GetStatistics();
+        cout << "Zeta surrogates: " << statistics.built << " built, " << statistics.rejected << " rejected, "
+             << "largest error bound " << statistics.largestErrorBound << endl;
+    }
+
     delete model;
 
     return 0;
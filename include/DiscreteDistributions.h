@@ -1,18 +1,25 @@
 #pragma once
 #include <vector>
+#include <limits>
+#include <memory>
+#include <utility>
 #include "RandomGen.h"
 
+class TailSummary;
+class ChunkedCDF;
+
 /**
  * Storage for a discrete empirical distribution with truncated xMin.
- * CDF values are calculated on initialization for fast runtime access.
+ * CDF values are calculated in chunks on their first access for fast runtime access, and evaluated directly past the
+ * memory budget of CDF tables.
  */
 class DiscreteEmpiricalDistribution
 {
 private:
     int _xMin, _xMax;
-    std::vector<double> _cdf;
+    std::shared_ptr<const ChunkedCDF> _cdf;
 
-    void PrecalculateCDF(const std::vector<int>& sortedTailSample);
+    void PrecalculateCDF(std::vector<int> sortedTailSample);
 public:
     /**
      * Power-law discrete empirical distribution with known xMin.
@@ -27,8 +34,9 @@ public:
 
 enum class DistributionType
 {
-    LeftBounded, // Type I
-    RightBounded // Type II
+    LeftBounded,  // Type I
+    RightBounded, // Type II
+    DoublyBounded // Type III
 };
 
 enum class DistributionState
@@ -36,6 +44,24 @@ enum class DistributionState
     Valid, NoInput, InvalidInput
 };
 
+enum class RuntimeMode
+{
+    SingleThread, MultiThread
+};
+
+enum class LowerBoundSearch
+{
+    FirstLocalMinimum, // Stop at the first local minimum of the KS statistic
+    GlobalMinimum      // Find the global minimum of the KS statistic over every candidate
+};
+
+enum class AlphaEstimator
+{
+    Grid, // Exhaustive search over a fixed grid of alpha values
+    Brent, // Bracketed 1-D maximization of the log-likelihood
+    Newton // Newton iteration on the likelihood equation, with analytic derivatives of the normalizing constant
+};
+
 /**
  * Implementation of a discrete power law distribution as described in https://arxiv.org/abs/0706.1062
  * Can be used for parameter estimation, generating a power-law distributed sample and obtaining PDF and CDF values.
@@ -45,71 +71,208 @@ class DiscretePowerLawDistribution
 private:
     DistributionType _distributionType;
     DistributionState _state;
+    AlphaEstimator _alphaEstimator;
+    LowerBoundSearch _lowerBoundSearch;
     double _alpha;
     double _ksStatistic;
     double _alphaPrecision;
     int _xMin, _xMax;
     int _sampleSize;
-    std::vector<double> _cdf;
+    int _smallestInterval;
+    int _minTailSize;
+    std::shared_ptr<const ChunkedCDF> _cdf;     // Shared by copies, since it only depends on the parameters
+
+    /// Default minimum xMax-xMin interval of right and doubly bounded fits.
+    static constexpr int DefaultSmallestInterval = 20;
+
+    /// Default minimum number of observations in the tail of an xMin candidate.
+    static constexpr int DefaultMinTailSize = 1;
+
+    /// Interval in which the bracketed estimators search for alpha.
+    static constexpr double AlphaLowerLimit = 1.50;
+    static constexpr double AlphaUpperLimit = 3.50;
 
-    static DistributionState InputValidator(const std::vector<int>& data);
-    static DistributionState InputValidator(const std::vector<int>& data, int xParameter, DistributionType distributionType);
+    /// Half width of the bracket searched around a warm start alpha.
+    static constexpr double WarmStartRadius = 0.05;
+
+    friend class LowerBoundScanner;
+    friend class UpperBoundScanner;
+    friend class JointBoundScanner;
+
+    static DistributionState InputValidator(const std::vector<int>& data, int minTailSize);
+    static DistributionState InputValidator(const TailSummary& summary, int xParameter, DistributionType distributionType);
+    static DistributionState InputValidator(const TailSummary& summary, int xMin, int xMax);
 
     /**
-     * Estimate Alpha for model type I
-     * @param data Sample data
+     * Alpha values evaluated by the grid estimator.
+     * @param precision Multiple of the desired alpha precision.
+     * @return Every multiple of the precision from 1.50 to 3.51.
+     */
+    static std::vector<double> AlphaGrid(double precision);
+
+    /**
+     * Smallest and largest alpha that an estimator can fit.
+     * @param precision Multiple of the desired alpha precision.
+     * @param estimator Method used to find the maximum of the log-likelihood.
+     * @return The ends of the grid for the grid estimator, which may lie outside the limits of the bracketed
+     * estimators by less than the precision, otherwise AlphaLowerLimit and AlphaUpperLimit.
+     */
+    static std::pair<double, double> AlphaRange(double precision, AlphaEstimator estimator);
+
+    /**
+     * Log-likelihood of every alpha of a grid, -n ln Z(alpha) - alpha * sum(ln x), from the normalizing constants.
+     * @param n Number of observations in the fitted range
+     * @param logXSum Sum of ln(x) over the fitted range
+     * @param alphaGrid Candidate alpha values
+     * @param normalizers Normalizing constant Z(alpha) of each alpha of the grid
+     * @return The log-likelihood profile over the grid
+     */
+    static std::vector<double> LogLikelihoodProfile(double n, double logXSum, const std::vector<double>& alphaGrid,
+                                                    const std::vector<double>& normalizers);
+
+    /**
+     * Find the alpha that maximizes a log-likelihood function.
+     * @param logLikelihood Log-likelihood as a function of alpha.
+     * @param precision Multiple of the desired alpha precision.
+     * @param estimator Grid evaluates every multiple of the precision, Brent converges to the precision. Newton is
+     * handled by the callers, which provide the derivatives of the log-likelihood.
+     * @param alphaGuess Warm start, usually the alpha of a neighbouring bound candidate. NaN searches the full range.
+     * @return The estimated value for alpha
+     */
+    template<typename LogLikelihood>
+    static double MaximizeLogLikelihood(const LogLikelihood& logLikelihood, double precision, AlphaEstimator estimator,
+                                        double alphaGuess = std::numeric_limits<double>::quiet_NaN());
+
+    /**
+     * Estimate Alpha for model type I. The Brent and warm started grid searches evaluate the normalizing constant
+     * through the Chebyshev surrogate of ln zeta(alpha, xMin) when surrogates are in use, see use_zeta_surrogates.
+     * @param summary Summary of the sample data
      * @param xMin Known xMin
      * @param precision Multiple of the desired alpha precision.
+     * @param estimator Method used to find the maximum of the log-likelihood
+     * @param alphaGuess Warm start of the search. NaN searches the full range.
      * @return The estimated value for alpha
      */
-    static double EstimateAlpha(const std::vector<int>& data, int xMin, double precision = 0.01);
+    static double EstimateAlpha(const TailSummary& summary, int xMin, double precision = 0.01,
+                                AlphaEstimator estimator = AlphaEstimator::Grid,
+                                double alphaGuess = std::numeric_limits<double>::quiet_NaN());
 
     /**
-     * Estimate Alpha for model type II
-     * @param data Sample data
+     * Estimate Alpha for model type I over a grid of alpha values, from precomputed normalizing constants
+     * @param summary Summary of the sample data
+     * @param xMin Known xMin
+     * @param alphaGrid Candidate alpha values
+     * @param zetaValues Values of zeta(alpha, xMin) for each alpha of the grid
+     * @param alphaGuess Warm start of the search. NaN searches the full grid.
+     * @return The estimated value for alpha
+     */
+    static double EstimateAlpha(const TailSummary& summary, int xMin, const std::vector<double>& alphaGrid,
+                                const std::vector<double>& zetaValues,
+                                double alphaGuess = std::numeric_limits<double>::quiet_NaN());
+
+    /**
+     * Estimate Alpha for model types II and III over a grid of alpha values, from precomputed normalizing constants
+     * @param summary Summary of the sample data
+     * @param xMin Known xMin
+     * @param xMax Known xMax
+     * @param alphaGrid Candidate alpha values
+     * @param normalizers Partial sums of x^-alpha for x = xMin..xMax, for each alpha of the grid
+     * @param alphaGuess Warm start of the search. NaN searches the full grid.
+     * @return The estimated value for alpha
+     */
+    static double EstimateAlpha(const TailSummary& summary, int xMin, int xMax, const std::vector<double>& alphaGrid,
+                                const std::vector<double>& normalizers,
+                                double alphaGuess = std::numeric_limits<double>::quiet_NaN());
+
+    /**
+     * Estimate Alpha for model types II and III
+     * @param summary Summary of the sample data
      * @param xMin Known xMin
      * @param xMax Known xMax
      * @param precision Multiple of the desired alpha precision
+     * @param estimator Method used to find the maximum of the log-likelihood
+     * @param alphaGuess Warm start of the search. NaN searches the full range.
      * @return The estimated value for alpha
      */
-    static double EstimateAlpha(const std::vector<int>& data, int xMin, int xMax, double precision = 0.01);
+    static double EstimateAlpha(const TailSummary& summary, int xMin, int xMax, double precision = 0.01,
+                                AlphaEstimator estimator = AlphaEstimator::Grid,
+                                double alphaGuess = std::numeric_limits<double>::quiet_NaN());
 
     /**
      * Calculate the estimated value for xMin
-     * @param data Sample data.
+     * @param summary Summary of the sample data.
      * @param precision Multiple of the desired alpha precision
-     * @return xMin value
+     * @param estimator Method used to estimate alpha for each candidate
+     * @param runtimeMode Whether to evaluate the candidates on the shared thread pool
+     * @param search Whether to stop at the first local minimum of the KS statistic or to find its global minimum
+     * @param minTailSize Minimum number of observations greater or equal than an xMin candidate
+     * @return xMin value, or 0 if no candidate has a tail of minTailSize observations
      */
-    static int EstimateLowerBound(const std::vector<int>& data, double precision = 0.01);
+    static int EstimateLowerBound(const TailSummary& summary, double precision = 0.01,
+                                  AlphaEstimator estimator = AlphaEstimator::Grid,
+                                  RuntimeMode runtimeMode = RuntimeMode::SingleThread,
+                                  LowerBoundSearch search = LowerBoundSearch::FirstLocalMinimum,
+                                  int minTailSize = DefaultMinTailSize);
 
     /**
      * Calculate the estimated value for xMax
-     * @param data Sample data
+     * @param summary Summary of the sample data
      * @param precision Multiple of the desired alpha precision
      * @param smallestInterval Minimum xMax-xMin interval
+     * @param estimator Method used to estimate alpha for each candidate
+     * @param runtimeMode Whether to evaluate the candidates on the shared thread pool
      * @return xMax value
      */
-    static int EstimateUpperBound(const std::vector<int>& data, double precision = 0.01, int smallestInterval = 20);
-
-    /// Log-likelihood for model type I
-    static double CalculateLogLikelihoodLeftBounded(const std::vector<int>& data, double alpha, int xMin);
+    static int EstimateUpperBound(const TailSummary& summary, double precision = 0.01,
+                                  int smallestInterval = DefaultSmallestInterval,
+                                  AlphaEstimator estimator = AlphaEstimator::Grid,
+                                  RuntimeMode runtimeMode = RuntimeMode::SingleThread);
 
-    /// Log-likelihood for model type II
-    static double CalculateLogLikelihoodRightBounded(const std::vector<int>& data, double alpha, int xMax);
+    /**
+     * Calculate the estimated values for xMin and xMax jointly, at the global minimum of the KS statistic
+     * @param summary Summary of the sample data
+     * @param precision Multiple of the desired alpha precision
+     * @param smallestInterval Minimum xMax-xMin interval
+     * @param estimator Method used to estimate alpha for each candidate
+     * @param runtimeMode Whether to evaluate the candidates on the shared thread pool
+     * @param minTailSize Minimum number of observations between the bounds of a candidate
+     * @return xMin and xMax values, or zeros if no pair of distinct values is a candidate
+     */
+    static std::pair<int, int> EstimateBounds(const TailSummary& summary, double precision = 0.01,
+                                              int smallestInterval = DefaultSmallestInterval,
+                                              AlphaEstimator estimator = AlphaEstimator::Grid,
+                                              RuntimeMode runtimeMode = RuntimeMode::SingleThread,
+                                              int minTailSize = DefaultMinTailSize);
 
-    /// Calculates the CDF for the model type I
-    static double CalculateCDF(int x, double alpha, int xMin);
+    /// Log-likelihood for model type I
+    static double CalculateLogLikelihoodLeftBounded(const TailSummary& summary, double alpha, int xMin);
 
-    /// Calculates the CDF for the model type II
-    static double CalculateCDF(int x, double alpha, int xMin, int xMax);
+    /// Log-likelihood for model types II and III
+    static double CalculateLogLikelihoodBounded(const TailSummary& summary, double alpha, int xMin, int xMax);
 
-    [[nodiscard]] double CalculateKSStatistic(const std::vector<int>& data) const;
+    [[nodiscard]] double CalculateKSStatistic(const std::vector<int>& data, const TailSummary& summary) const;
     [[nodiscard]] int BinarySearch(int l, int r, double x) const;
     [[nodiscard]] double GetStandardError(int sampleSize) const;
 
-    /// Precomputes the cumulative distribution function for fast access
+    /// Prepares the cumulative distribution function for fast access, within the memory budget of CDF tables
     void PrecalculateCDF();
 
+    /**
+     * Constructor for a distribution with known xParameter that reuses the summary of the sample.
+     */
+    DiscretePowerLawDistribution(const std::vector<int>& sampleData, const TailSummary& summary, int xParameter,
+                                 double alphaPrecision, DistributionType distributionType, AlphaEstimator alphaEstimator);
+
+    /**
+     * Constructor for a type III distribution with known xMin and xMax that reuses the summary of the sample.
+     */
+    DiscretePowerLawDistribution(const std::vector<int>& sampleData, const TailSummary& summary, int xMin, int xMax,
+                                 double alphaPrecision, AlphaEstimator alphaEstimator);
+
+    /// Assigns the parameters of a distribution with known bounds and alpha, and precomputes its CDF.
+    void AssignParameters(const std::vector<int>& sampleData, const TailSummary& summary, int xMin, int xMax,
+                          double alpha);
+
 public:
     /**
      * Copy constructor
@@ -122,17 +285,42 @@ public:
      * @param xParameter Known value for the xParameter parameter
      * @param alphaPrecision Multiple of the desired alpha precision
      * @param testStatisticType The type of test statistic that will be used for gof estimation
+     * @param alphaEstimator Method used to find the maximum likelihood alpha
      */
     DiscretePowerLawDistribution(const std::vector<int>& sampleData, int xParameter, double alphaPrecision = 0.01,
-                                 DistributionType distributionType = DistributionType::LeftBounded);
+                                 DistributionType distributionType = DistributionType::LeftBounded,
+                                 AlphaEstimator alphaEstimator = AlphaEstimator::Grid);
+
+    /**
+     * Constructor for a type III distribution with known xMin and xMax. Estimates alpha from the sample.
+     * @param sampleData Sample data to estimate alpha from
+     * @param xMin Known lower bound
+     * @param xMax Known upper bound
+     * @param alphaPrecision Multiple of the desired alpha precision
+     * @param alphaEstimator Method used to find the maximum likelihood alpha
+     */
+    DiscretePowerLawDistribution(const std::vector<int>& sampleData, int xMin, int xMax, double alphaPrecision = 0.01,
+                                 AlphaEstimator alphaEstimator = AlphaEstimator::Grid);
 
     /**
-     * Constructor for a distribution with no known parameters. Estimates alpha and xMin from the sample data.
+     * Constructor for a distribution with no known parameters. Estimates alpha and the bounds of the model from the
+     * sample data.
      * @param sampleData Data for the parameter estimation.
+     * @param alphaEstimator Method used to find the maximum likelihood alpha
+     * @param runtimeMode Whether to scan the bound candidates on the shared thread pool. Use SingleThread when
+     * constructing from a task that already runs on the pool.
+     * @param lowerBoundSearch Whether xMin is the first local minimum or the global minimum of the KS statistic
+     * @param minTailSize Minimum number of observations greater or equal than an xMin candidate, or between the bounds
+     * of a candidate of the doubly bounded model. It must be from 1 to the sample size, and the state is InvalidInput
+     * otherwise, or if no bound candidate is left.
      */
     explicit DiscretePowerLawDistribution(const std::vector<int>& sampleData, double alphaPrecision = 0.01,
                                           DistributionType distributionType = DistributionType::LeftBounded,
-                                          int smallestInterval = 20);
+                                          int smallestInterval = DefaultSmallestInterval,
+                                          AlphaEstimator alphaEstimator = AlphaEstimator::Grid,
+                                          RuntimeMode runtimeMode = RuntimeMode::SingleThread,
+                                          LowerBoundSearch lowerBoundSearch = LowerBoundSearch::FirstLocalMinimum,
+                                          int minTailSize = DefaultMinTailSize);
 
     /**
      * Generates a sequence of n power-law distributed random numbers.
@@ -161,6 +349,18 @@ public:
     /// Obtain the precision in which estimate alpha values.
     [[nodiscard]] double GetAlphaPrecision() const;
 
+    /// Obtain the method used to estimate alpha.
+    [[nodiscard]] AlphaEstimator GetAlphaEstimator() const;
+
+    /// Obtain the strategy used to estimate xMin.
+    [[nodiscard]] LowerBoundSearch GetLowerBoundSearch() const;
+
+    /// Obtain the minimum xMax-xMin interval used when estimating xMax.
+    [[nodiscard]] int GetSmallestInterval() const;
+
+    /// Obtain the minimum tail size of the xMin candidates.
+    [[nodiscard]] int GetMinTailSize() const;
+
     /// Obtain the estimated standard error for alpha.
     [[nodiscard]] double GetStandardError() const;
 
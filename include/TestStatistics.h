@@ -2,11 +2,6 @@
 #include <vector>
 #include "DiscreteDistributions.h"
 
-enum class RuntimeMode
-{
-    SingleThread, MultiThread
-};
-
 /**
  * Calculates the goodness of fit of a power-law model.
  * @param fittedModel Reference to the fitted power-law model.
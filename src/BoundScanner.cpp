@@ -0,0 +1,390 @@
+#include "BoundScanner.h"
+#include "Zeta.h"
+#include "ZetaCache.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <tuple>
+#include <utility>
+using namespace std;
+
+/// Longest gap between distinct values that is walked term by term instead of evaluating the zeta function.
+constexpr int MaxWalkedGap = 64;
+
+/// zeta(alpha, first) and zeta(alpha, second), evaluated together by the vector kernel.
+pair<double, double> hurwitz_zeta_pair(double alpha, int first, int second)
+{
+    const array<double, 2> exponents = { alpha, alpha };
+    const array<double, 2> arguments = { (double) first, (double) second };
+    array<double, 2> values;
+    real_hurwitz_zeta_pairs(exponents, arguments, values);
+    return { values[0], values[1] };
+}
+
+/// Number of distinct values of the sample in the window of a zeta recurrence that holds x.
+int window_reads(const TailSummary& summary, const HurwitzZetaRecurrence& recurrence, int x)
+{
+    const auto [windowStart, windowEnd] = recurrence.WindowBounds(x);
+    return summary.LowerBoundIndex(windowEnd) - summary.LowerBoundIndex(windowStart);
+}
+
+/******************************************
+*           LowerBoundScanner             *
+******************************************/
+
+LowerBoundScanner::LowerBoundScanner(const TailSummary& summary, double alphaPrecision, AlphaEstimator alphaEstimator)
+: _summary(summary),
+  _alphaGrid((alphaEstimator == AlphaEstimator::Grid) ? DiscretePowerLawDistribution::AlphaGrid(alphaPrecision) : vector<double>()),
+  _zetaRecurrence(_alphaGrid)
+{
+    _alphaPrecision = alphaPrecision;
+    _alphaEstimator = alphaEstimator;
+    tie(_lowerAlpha, _upperAlpha) = DiscretePowerLawDistribution::AlphaRange(alphaPrecision, alphaEstimator);
+    _previousAlpha = numeric_limits<double>::quiet_NaN();
+}
+
+BoundCandidate LowerBoundScanner::Evaluate(int xMin, double ksThreshold)
+{
+    if (ksThreshold < numeric_limits<double>::infinity())
+    {
+        // The grid of some precisions starts below the lower limit, so the bound brackets the range of the estimator
+        // instead of the limits.
+        const double ksLowerBound = left_bounded_ks_lower_bound(_summary, xMin, _lowerAlpha, _upperAlpha);
+        if (ksLowerBound > ksThreshold)
+            return { xMin, numeric_limits<double>::quiet_NaN(), ksLowerBound };
+    }
+
+    double alpha;
+    if (_alphaEstimator == AlphaEstimator::Grid)
+    {
+        // The candidates of sparse tails are evaluated directly, instead of filling a window for each of them.
+        _zetaRecurrence.Seek(xMin, window_reads(_summary, _zetaRecurrence, xMin));
+        alpha = DiscretePowerLawDistribution::EstimateAlpha(_summary, xMin, _alphaGrid, _zetaRecurrence.GetValues(),
+                                                            _previousAlpha);
+    }
+    else
+        alpha = DiscretePowerLawDistribution::EstimateAlpha(_summary, xMin, _alphaPrecision, _alphaEstimator,
+                                                            _previousAlpha);
+    _previousAlpha = alpha;
+
+    const double normalizer = cached_hurwitz_zeta(alpha, xMin);
+    return { xMin, alpha, left_bounded_ks_statistic(_summary, alpha, xMin, normalizer, ksThreshold) };
+}
+
+void LowerBoundScanner::ResetWarmStart()
+{
+    _previousAlpha = numeric_limits<double>::quiet_NaN();
+}
+
+/******************************************
+*           UpperBoundScanner             *
+******************************************/
+
+UpperBoundScanner::UpperBoundScanner(const TailSummary& summary, double alphaPrecision, AlphaEstimator alphaEstimator)
+: _summary(summary),
+  _alphaGrid((alphaEstimator == AlphaEstimator::Grid) ? DiscretePowerLawDistribution::AlphaGrid(alphaPrecision) : vector<double>()),
+  _normalizers(_alphaGrid.size()),
+  _tailZetaRecurrence(_alphaGrid)
+{
+    _alphaPrecision = alphaPrecision;
+    _alphaEstimator = alphaEstimator;
+    _previousAlpha = numeric_limits<double>::quiet_NaN();
+    real_hurwitz_zeta_batch(_alphaGrid, 1, _headZetaValues);
+}
+
+BoundCandidate UpperBoundScanner::Evaluate(int xMax, double ksThreshold)
+{
+    // Bounds that leave the sample empty are invalid, as in the model constructor.
+    if (xMax <= _summary.Min())
+        return { xMax, numeric_limits<double>::quiet_NaN(), numeric_limits<double>::infinity() };
+
+    double alpha;
+    if (_alphaEstimator == AlphaEstimator::Grid)
+    {
+        // The normalizing constants are partial sums of x^-alpha up to xMax.
+        _tailZetaRecurrence.Seek(xMax + 1);
+        const vector<double>& tailZetaValues = _tailZetaRecurrence.GetValues();
+        for (size_t i = 0; i < _alphaGrid.size(); ++i)
+            _normalizers[i] = _headZetaValues[i] - tailZetaValues[i];
+
+        alpha = DiscretePowerLawDistribution::EstimateAlpha(_summary, 1, xMax, _alphaGrid, _normalizers,
+                                                            _previousAlpha);
+    }
+    else
+        alpha = DiscretePowerLawDistribution::EstimateAlpha(_summary, 1, xMax, _alphaPrecision, _alphaEstimator,
+                                                            _previousAlpha);
+    _previousAlpha = alpha;
+
+    const auto [headZeta, tailZeta] = hurwitz_zeta_pair(alpha, 1, xMax + 1);
+    const double normalizer = headZeta - tailZeta;
+    return { xMax, alpha, bounded_ks_statistic(_summary, alpha, 1, xMax, normalizer, tailZeta, ksThreshold) };
+}
+
+void UpperBoundScanner::ResetWarmStart()
+{
+    _previousAlpha = numeric_limits<double>::quiet_NaN();
+}
+
+/******************************************
+*          DistinctValueZetaTable         *
+******************************************/
+
+DistinctValueZetaTable::DistinctValueZetaTable(const TailSummary& summary, vector<double> alphas)
+: _alphas(std::move(alphas))
+{
+    const vector<int>& values = summary.GetValues();
+    const size_t alphaCount = _alphas.size();
+    _atValues.assign(values.size() * alphaCount, numeric_limits<double>::quiet_NaN());
+    _afterValues.assign(values.size() * alphaCount, numeric_limits<double>::quiet_NaN());
+    if (alphaCount == 0)
+        return;
+
+    // Two arguments are read for every distinct value, so the values of sparse tails are evaluated directly.
+    HurwitzZetaRecurrence zetaRecurrence(_alphas);
+    for (int index = summary.LowerBoundIndex(1); index < summary.GetDistinctSize(); ++index)
+    {
+        const int x = values[index];
+        zetaRecurrence.Seek(x, 2 * window_reads(summary, zetaRecurrence, x));
+        copy(zetaRecurrence.GetValues().begin(), zetaRecurrence.GetValues().end(), &_atValues[index * alphaCount]);
+        zetaRecurrence.Seek(x + 1, 2 * window_reads(summary, zetaRecurrence, x + 1));
+        copy(zetaRecurrence.GetValues().begin(), zetaRecurrence.GetValues().end(), &_afterValues[index * alphaCount]);
+    }
+}
+
+const vector<double>& DistinctValueZetaTable::GetAlphas() const
+{
+    return _alphas;
+}
+
+/******************************************
+*           JointBoundScanner             *
+******************************************/
+
+JointBoundScanner::JointBoundScanner(const TailSummary& summary, const DistinctValueZetaTable& boundZetaTable,
+                                     const DistinctValueZetaTable& gridZetaTable, double alphaPrecision,
+                                     AlphaEstimator alphaEstimator)
+: _summary(summary),
+  _boundZetaTable(boundZetaTable),
+  _gridZetaTable(gridZetaTable),
+  _normalizers(gridZetaTable.GetAlphas().size())
+{
+    _alphaPrecision = alphaPrecision;
+    _alphaEstimator = alphaEstimator;
+    _previousAlpha = numeric_limits<double>::quiet_NaN();
+}
+
+vector<double> JointBoundScanner::BoundAlphas(double alphaPrecision, AlphaEstimator alphaEstimator)
+{
+    // Powers of two divide the range exactly, so the levels are exact. The grid of some precisions starts slightly
+    // below the lower limit and ends slightly above the upper one, so the levels are anchored at the lower limit and
+    // extended until they cover the alphas that the estimator can fit.
+    const double lowerLimit = DiscretePowerLawDistribution::AlphaLowerLimit;
+    const double upperLimit = DiscretePowerLawDistribution::AlphaUpperLimit;
+    double spacing = MinBoundAlphaSpacing;
+    while (spacing < 2.0 * alphaPrecision && spacing < upperLimit - lowerLimit)
+        spacing *= 2.0;
+
+    const auto [lowerAlpha, upperAlpha] = DiscretePowerLawDistribution::AlphaRange(alphaPrecision, alphaEstimator);
+    const auto firstLevel = (int) floor((lowerAlpha - lowerLimit) / spacing);
+    const auto lastLevel = (int) ceil((upperAlpha - lowerLimit) / spacing);
+    vector<double> alphas;
+    for (int k = firstLevel; k <= lastLevel; ++k)
+        alphas.push_back(lowerLimit + k * spacing);
+    return alphas;
+}
+
+double JointBoundScanner::KSLowerBound(int first, int last, double ksThreshold) const
+{
+    const vector<double>& boundAlphas = _boundZetaTable.GetAlphas();
+    const int numberAfterRange = _summary.NumberFromIndex(last + 1);
+    const auto n = (double) (_summary.NumberFromIndex(first) - numberAfterRange);
+    const double logXSum = _summary.LogSumInRange(_summary.GetValues()[first], _summary.GetValues()[last]);
+
+    // The log-likelihood is concave in alpha, so its best level is found by bisection on the sign of its differences
+    // between levels. The maximum is within one level of the best one, and every estimator fits alpha within its
+    // precision of the maximum, which is less than the level spacing, or at the end of its range next to the maximum.
+    // The levels cover that range, so the bracket below holds the fitted alpha in both cases.
+    const auto logLikelihood = [&](size_t k)
+    {
+        const double normalizer = _boundZetaTable.AtValue(first, k) - _boundZetaTable.AfterValue(last, k);
+        return - n * log(normalizer) - boundAlphas[k] * logXSum;
+    };
+    size_t bestLevel = 0;
+    size_t levelEnd = boundAlphas.size() - 1;
+    while (bestLevel < levelEnd)
+    {
+        const size_t k = bestLevel + (levelEnd - bestLevel) / 2;
+        if (logLikelihood(k + 1) > logLikelihood(k))
+            bestLevel = k + 1;
+        else
+            levelEnd = k;
+    }
+    const size_t lowerLevel = (bestLevel >= 2) ? bestLevel - 2 : 0;
+    const size_t upperLevel = min(bestLevel + 2, boundAlphas.size() - 1);
+
+    // The lower alpha of the bracket gives the largest model CDF, and the upper one the smallest.
+    const double upperTailZeta = _boundZetaTable.AfterValue(last, lowerLevel);
+    const double lowerTailZeta = _boundZetaTable.AfterValue(last, upperLevel);
+    const double upperNormalizer = _boundZetaTable.AtValue(first, lowerLevel) - upperTailZeta;
+    const double lowerNormalizer = _boundZetaTable.AtValue(first, upperLevel) - lowerTailZeta;
+
+    // Both ends of the range are tested first, where the bound is usually the largest, then values at doubling
+    // distances from them.
+    double bound = 0.0;
+    const auto testPoint = [&](int index, bool afterValue)
+    {
+        const auto zeta = [&](size_t k)
+        {
+            return afterValue ? _boundZetaTable.AfterValue(index, k) : _boundZetaTable.AtValue(index, k);
+        };
+        const double empiricalCdf = (_summary.NumberFromIndex(afterValue ? index + 1 : index) - numberAfterRange) / n;
+        const double upperCdf = (zeta(lowerLevel) - upperTailZeta) / upperNormalizer;
+        const double lowerCdf = (zeta(upperLevel) - lowerTailZeta) / lowerNormalizer;
+        bound = max({ bound, lowerCdf - empiricalCdf, empiricalCdf - upperCdf });
+        return bound > ksThreshold;
+    };
+
+    if (testPoint(first, true) || testPoint(last, false))
+        return bound;
+    for (int step = 1; first + step < last; step *= 2)
+    {
+        if (testPoint(first + step, false) || testPoint(first + step, true) ||
+            testPoint(last - step, false) || testPoint(last - step, true))
+            return bound;
+    }
+
+    return bound;
+}
+
+BoundPairCandidate JointBoundScanner::Evaluate(int first, int last, double ksThreshold)
+{
+    const int xMin = _summary.GetValues()[first];
+    const int xMax = _summary.GetValues()[last];
+    if (ksThreshold < numeric_limits<double>::infinity())
+    {
+        const double ksLowerBound = KSLowerBound(first, last, ksThreshold);
+        if (ksLowerBound > ksThreshold)
+            return { xMin, xMax, numeric_limits<double>::quiet_NaN(), ksLowerBound };
+    }
+
+    double alpha, headZeta, tailZeta;
+    if (_alphaEstimator == AlphaEstimator::Grid)
+    {
+        const vector<double>& alphaGrid = _gridZetaTable.GetAlphas();
+        for (size_t k = 0; k < alphaGrid.size(); ++k)
+            _normalizers[k] = _gridZetaTable.AtValue(first, k) - _gridZetaTable.AfterValue(last, k);
+
+        alpha = DiscretePowerLawDistribution::EstimateAlpha(_summary, xMin, xMax, alphaGrid, _normalizers,
+                                                            _previousAlpha);
+        const size_t k = lower_bound(alphaGrid.begin(), alphaGrid.end(), alpha) - alphaGrid.begin();
+        headZeta = _gridZetaTable.AtValue(first, k);
+        tailZeta = _gridZetaTable.AfterValue(last, k);
+    }
+    else
+    {
+        alpha = DiscretePowerLawDistribution::EstimateAlpha(_summary, xMin, xMax, _alphaPrecision, _alphaEstimator,
+                                                            _previousAlpha);
+        tie(headZeta, tailZeta) = hurwitz_zeta_pair(alpha, xMin, xMax + 1);
+    }
+    _previousAlpha = alpha;
+
+    const double ksStatistic = bounded_ks_statistic(_summary, alpha, xMin, xMax, headZeta - tailZeta, tailZeta,
+                                                    ksThreshold);
+    return { xMin, xMax, alpha, ksStatistic };
+}
+
+void JointBoundScanner::ResetWarmStart()
+{
+    _previousAlpha = numeric_limits<double>::quiet_NaN();
+}
+
+/******************************************
+*             KS statistics               *
+******************************************/
+
+/// Moves zeta(alpha, x) to zeta(alpha, target), term by term for short gaps.
+double advance_zeta(double zeta, double alpha, int x, int target)
+{
+    if (target - x > MaxWalkedGap)
+        return cached_hurwitz_zeta(alpha, target);
+
+    for (; x < target; ++x)
+        zeta -= pow((double) x, -alpha);
+    return zeta;
+}
+
+double left_bounded_ks_lower_bound(const TailSummary& summary, int xMin, double lowerAlpha, double upperAlpha)
+{
+    const int first = summary.LowerBoundIndex(xMin);
+    if (first + 1 >= summary.GetDistinctSize())
+        return 0.0;
+
+    const auto n = (double) summary.NumberFromIndex(first);
+    const int x = summary.GetValues()[first];
+
+    // Model CDFs at x and x + 1 for the ends of the alpha interval, from four independent zeta values.
+    const array<double, 4> exponents = { lowerAlpha, upperAlpha, lowerAlpha, upperAlpha };
+    const array<double, 4> arguments = { (double) xMin, (double) xMin, (double) x, (double) x };
+    array<double, 4> zetas;
+    real_hurwitz_zeta_pairs(exponents, arguments, zetas);
+    const double lowerAlphaNormalizer = zetas[0];
+    const double upperAlphaNormalizer = zetas[1];
+    const double lowerAlphaZeta = zetas[2];
+    const double upperAlphaZeta = zetas[3];
+    const double upperCdfAtX = lowerAlphaZeta / lowerAlphaNormalizer;
+    const double upperCdfAfterX = (lowerAlphaZeta - pow((double) x, -lowerAlpha)) / lowerAlphaNormalizer;
+    const double lowerCdfAfterX = (upperAlphaZeta - pow((double) x, -upperAlpha)) / upperAlphaNormalizer;
+
+    // The empirical CDF is one up to x, and drops by the relative count of x after it.
+    const double empiricalCdfAfterX = summary.NumberFromIndex(first + 1) / n;
+    const double boundAtX = 1.0 - upperCdfAtX;
+    const double boundAfterX = max(lowerCdfAfterX - empiricalCdfAfterX, empiricalCdfAfterX - upperCdfAfterX);
+    return max({ boundAtX, boundAfterX, 0.0 });
+}
+
+double bounded_ks_statistic(const TailSummary& summary, double alpha, int xMin, int xMax, double normalizer,
+                            double tailZeta, double ksThreshold)
+{
+    const vector<int>& values = summary.GetValues();
+    const int first = summary.LowerBoundIndex(xMin);
+    const int end = summary.UpperBoundIndex(xMax);
+    const int numberAfterRange = summary.NumberFromIndex(end);
+    const auto n = (double) (summary.NumberFromIndex(first) - numberAfterRange);
+    if (n == 0)
+        return numeric_limits<double>::infinity();
+
+    // The empirical CDF is constant on each segment (values[j - 1], values[j]] and the model one decreases,
+    // so the largest difference on a segment is found at one of its ends.
+    double maxDiff = 0.0;
+    int x = xMin;
+    double zeta = normalizer + tailZeta;
+    for (int j = first; j < end; ++j)
+    {
+        const double empiricalCdf = (summary.NumberFromIndex(j) - numberAfterRange) / n;
+        maxDiff = max(maxDiff, abs(empiricalCdf - (zeta - tailZeta) / normalizer));
+
+        zeta = advance_zeta(zeta, alpha, x, values[j]);
+        x = values[j];
+        maxDiff = max(maxDiff, abs(empiricalCdf - (zeta - tailZeta) / normalizer));
+        if (maxDiff > ksThreshold)
+            return maxDiff;
+
+        if (x < xMax)
+        {
+            zeta -= pow((double) x, -alpha);
+            x++;
+        }
+    }
+
+    // Past the last observation of the range the empirical CDF is zero, and the model one is largest right after it.
+    if (values[end - 1] < xMax)
+        maxDiff = max(maxDiff, (zeta - tailZeta) / normalizer);
+
+    return maxDiff;
+}
+
+double left_bounded_ks_statistic(const TailSummary& summary, double alpha, int xMin, double normalizer,
+                                 double ksThreshold)
+{
+    return bounded_ks_statistic(summary, alpha, xMin, summary.Max(), normalizer, 0.0, ksThreshold);
+}
@@ -0,0 +1,255 @@
+#pragma once
+#include <vector>
+#include <limits>
+#include "../include/DiscreteDistributions.h"
+#include "TailSummary.h"
+#include "ZetaRecurrence.h"
+#include "SharedThreadPool.h"
+
+/// Number of consecutive candidates evaluated by each task of a parallel scan.
+constexpr int ScanBlockSize = 8;
+
+/// Number of blocks of a wave in pruned scans. The waves of these scans have a fixed size, so the pruning threshold
+/// of every block, and with it the warm start of every fitted candidate, does not depend on the number of threads.
+constexpr int PrunedScanWaveBlocks = 32;
+
+/// Number of blocks that a bound scan evaluates at once.
+inline int scan_block_count(RuntimeMode runtimeMode)
+{
+    return (runtimeMode == RuntimeMode::MultiThread) ? (int) shared_thread_pool().get_thread_count() : 1;
+}
+
+/// Calls loop(block) for every block in [0, blockCount), on the shared thread pool in the MultiThread mode.
+template<typename F> void for_each_scan_block(int blockCount, RuntimeMode runtimeMode, const F& loop)
+{
+    if (runtimeMode == RuntimeMode::MultiThread && blockCount > 1)
+        parallel_for_blocks(blockCount, loop);
+    else
+    {
+        for (int block = 0; block < blockCount; ++block)
+            loop(block);
+    }
+}
+
+/// Fitted alpha and KS statistic of the model at one bound candidate. Pruned candidates have no alpha and report a
+/// lower bound of their KS statistic.
+struct BoundCandidate
+{
+    int xParameter;
+    double alpha;
+    double ksStatistic;
+};
+
+/// Fitted alpha and KS statistic of the model at one (xMin, xMax) candidate of the joint bound scan.
+struct BoundPairCandidate
+{
+    int xMin;
+    int xMax;
+    double alpha;
+    double ksStatistic;
+};
+
+/**
+ * Scan engine for the xMin candidates of the left bounded model.
+ * Works on the sorted summary of the sample and keeps the grid normalizing constants as xMin advances, so each
+ * candidate is fitted and tested without building a model or allocating memory. The alpha search of each candidate
+ * is warm started from the alpha of the previous one.
+ */
+class LowerBoundScanner
+{
+private:
+    const TailSummary& _summary;
+    double _alphaPrecision;
+    AlphaEstimator _alphaEstimator;
+    std::vector<double> _alphaGrid;
+    HurwitzZetaRecurrence _zetaRecurrence;
+    double _lowerAlpha, _upperAlpha;    // Range of the alphas that the estimator can fit
+    double _previousAlpha;
+
+public:
+    /**
+     * @param summary Summary of the sample data.
+     * @param alphaPrecision Multiple of the desired alpha precision.
+     * @param alphaEstimator Method used to estimate alpha for each candidate.
+     */
+    LowerBoundScanner(const TailSummary& summary, double alphaPrecision, AlphaEstimator alphaEstimator);
+
+    /**
+     * Fit the left bounded model with the given xMin and measure its KS statistic.
+     * @param xMin Candidate lower bound.
+     * @param ksThreshold Candidates whose KS statistic is proven to be larger than this value are pruned. The proof
+     * holds for every alpha that the estimator can fit, so pruning never changes the result of a scan.
+     */
+    BoundCandidate Evaluate(int xMin, double ksThreshold = std::numeric_limits<double>::infinity());
+
+    /// Makes the next candidate search the full alpha range.
+    void ResetWarmStart();
+};
+
+/**
+ * Scan engine for the xMax candidates of the right bounded model.
+ * Takes the size and log-sum of the range x <= xMax from the sorted summary, and in grid mode keeps the normalizing
+ * constants of every alpha as xMax advances, so each candidate is fitted and tested without building a model.
+ * The alpha search of each candidate is warm started from the alpha of the previous one.
+ */
+class UpperBoundScanner
+{
+private:
+    const TailSummary& _summary;
+    double _alphaPrecision;
+    AlphaEstimator _alphaEstimator;
+    std::vector<double> _alphaGrid;
+    std::vector<double> _headZetaValues;    // zeta(alpha, 1) for each alpha of the grid
+    std::vector<double> _normalizers;
+    HurwitzZetaRecurrence _tailZetaRecurrence;
+    double _previousAlpha;
+
+public:
+    /**
+     * @param summary Summary of the sample data.
+     * @param alphaPrecision Multiple of the desired alpha precision.
+     * @param alphaEstimator Method used to estimate alpha for each candidate.
+     */
+    UpperBoundScanner(const TailSummary& summary, double alphaPrecision, AlphaEstimator alphaEstimator);
+
+    /**
+     * Fit the right bounded model with the given xMax and measure its KS statistic.
+     * @param xMax Candidate upper bound.
+     * @param ksThreshold The KS walk stops once the statistic exceeds this value, and reports the partial maximum.
+     */
+    BoundCandidate Evaluate(int xMax, double ksThreshold = std::numeric_limits<double>::infinity());
+
+    /// Makes the next candidate search the full alpha range.
+    void ResetWarmStart();
+};
+
+/**
+ * Values of zeta(alpha, v) and zeta(alpha, v + 1) at every distinct value v >= 1 of a sample, for a fixed set of
+ * alphas.
+ * The normalizing constant of a bounded model whose bounds are distinct values, and its CDF at the distinct values and
+ * right after them, are differences of two entries of the table.
+ */
+class DistinctValueZetaTable
+{
+private:
+    std::vector<double> _alphas;
+    std::vector<double> _atValues;      // zeta(alpha, v), one row per distinct value
+    std::vector<double> _afterValues;   // zeta(alpha, v + 1), one row per distinct value
+
+public:
+    /**
+     * @param summary Summary of the sample data.
+     * @param alphas Exponents of the table.
+     */
+    DistinctValueZetaTable(const TailSummary& summary, std::vector<double> alphas);
+
+    /// zeta(alphas[k], v) for the distinct value v at the given index.
+    [[nodiscard]] double AtValue(int index, size_t k) const
+    {
+        return _atValues[index * _alphas.size() + k];
+    }
+
+    /// zeta(alphas[k], v + 1) for the distinct value v at the given index.
+    [[nodiscard]] double AfterValue(int index, size_t k) const
+    {
+        return _afterValues[index * _alphas.size() + k];
+    }
+
+    [[nodiscard]] const std::vector<double>& GetAlphas() const;
+};
+
+/**
+ * Scan engine for the (xMin, xMax) candidates of the doubly bounded model, whose bounds are both distinct values.
+ * Sizes and log-sums of each range come from the sorted summary and the normalizing constants from tables of zeta
+ * at the distinct values, so in grid mode a candidate is fitted without evaluating the zeta function. Candidates are
+ * first tested against a KS lower bound valid for every alpha, which is also read from a table. The alpha search of
+ * each candidate is warm started from the alpha of the previous one.
+ */
+class JointBoundScanner
+{
+private:
+    const TailSummary& _summary;
+    const DistinctValueZetaTable& _boundZetaTable;  // At the ends of the alpha range
+    const DistinctValueZetaTable& _gridZetaTable;   // At every alpha of the grid, empty for the other estimators
+    double _alphaPrecision;
+    AlphaEstimator _alphaEstimator;
+    std::vector<double> _normalizers;
+    double _previousAlpha;
+
+public:
+    /**
+     * @param summary Summary of the sample data.
+     * @param boundZetaTable Table at the alpha levels of BoundAlphas.
+     * @param gridZetaTable Table at the alpha grid of the precision in grid mode, otherwise an empty table.
+     * @param alphaPrecision Multiple of the desired alpha precision.
+     * @param alphaEstimator Method used to estimate alpha for each candidate.
+     */
+    JointBoundScanner(const TailSummary& summary, const DistinctValueZetaTable& boundZetaTable,
+                      const DistinctValueZetaTable& gridZetaTable, double alphaPrecision,
+                      AlphaEstimator alphaEstimator);
+
+    /// Smallest spacing of the alpha levels of the KS lower bound table.
+    static constexpr double MinBoundAlphaSpacing = 1.0 / 64;
+
+    /**
+     * Alpha levels of the table used by the KS lower bounds, evenly spaced over the alphas that the estimator can fit.
+     * @param alphaPrecision Multiple of the desired alpha precision. The spacing is the smallest power of two that is
+     * at least twice the precision.
+     * @param alphaEstimator Method used to estimate alpha for each candidate.
+     */
+    static std::vector<double> BoundAlphas(double alphaPrecision, AlphaEstimator alphaEstimator);
+
+    /**
+     * Lower bound of the KS statistic of the doubly bounded model with the given bounds and its fitted alpha.
+     * The levels of the table next to the largest log-likelihood bracket the fitted alpha, and the model CDF decreases
+     * with alpha at every x > xMin, so at the distinct values of the range, and right after them, the model CDF is
+     * enclosed by the CDFs of the bracket ends. The ends of the range are tested first, then values at growing
+     * distances from them.
+     * @param first Index of the distinct value used as xMin.
+     * @param last Index of the distinct value used as xMax.
+     * @param ksThreshold The walk stops as soon as the bound exceeds this value.
+     */
+    [[nodiscard]] double KSLowerBound(int first, int last, double ksThreshold) const;
+
+    /**
+     * Fit the doubly bounded model with the given bounds and measure its KS statistic.
+     * @param first Index of the distinct value used as xMin.
+     * @param last Index of the distinct value used as xMax.
+     * @param ksThreshold Candidates whose KS statistic is proven to be larger than this value are pruned. The proof
+     * holds for every alpha that the estimator can fit, so pruning never changes the result of a scan.
+     */
+    BoundPairCandidate Evaluate(int first, int last, double ksThreshold = std::numeric_limits<double>::infinity());
+
+    /// Makes the next candidate search the full alpha range.
+    void ResetWarmStart();
+};
+
+/**
+ * Lower bound of the KS statistic of the left bounded model with the given xMin and any alpha in an interval.
+ * The model CDF decreases with alpha at every x > xMin, so around the first distinct value of the tail it is enclosed by
+ * the CDFs of the interval ends, and the empirical CDF there is known from the tail counts.
+ */
+double left_bounded_ks_lower_bound(const TailSummary& summary, int xMin, double lowerAlpha, double upperAlpha);
+
+/**
+ * KS statistic between the range xMin <= x <= xMax of a sample and the power-law model on that range, whose CDF is
+ * (zeta(alpha, x) - zeta(alpha, xMax + 1)) / (zeta(alpha, xMin) - zeta(alpha, xMax + 1)).
+ * The empirical CDF is constant between distinct values, so the model is only evaluated at the ends of each
+ * constant segment.
+ * @param summary Summary of the sample data.
+ * @param alpha Model exponent.
+ * @param xMin Model lower bound.
+ * @param xMax Model upper bound.
+ * @param normalizer Value of zeta(alpha, xMin) - zeta(alpha, xMax + 1).
+ * @param tailZeta Value of zeta(alpha, xMax + 1), zero for the left bounded model.
+ * @param ksThreshold The walk stops as soon as the statistic exceeds this value, and returns the partial maximum.
+ */
+double bounded_ks_statistic(const TailSummary& summary, double alpha, int xMin, int xMax, double normalizer,
+                            double tailZeta, double ksThreshold = std::numeric_limits<double>::infinity());
+
+/**
+ * KS statistic between the tail x >= xMin of a sample and the left bounded model.
+ * @param normalizer Value of zeta(alpha, xMin).
+ */
+double left_bounded_ks_statistic(const TailSummary& summary, double alpha, int xMin, double normalizer,
+                                 double ksThreshold = std::numeric_limits<double>::infinity());
@@ -0,0 +1,115 @@
+#include "ChunkedCDF.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace
+{
+    atomic<size_t> memoryBudget = ChunkedCDF::DefaultMemoryBudget;
+    atomic<size_t> memoryUse = 0;
+
+    /// Adds bytes to the memory use of all the tables, unless that would exceed the budget.
+    bool charge(size_t bytes)
+    {
+        size_t use = memoryUse.load(memory_order_relaxed);
+        do
+        {
+            if (use + bytes > memoryBudget.load(memory_order_relaxed))
+                return false;
+        } while (!memoryUse.compare_exchange_weak(use, use + bytes, memory_order_relaxed));
+        return true;
+    }
+}
+
+const double ChunkedCDF::Direct[1] = { 0.0 };
+
+ChunkedCDF::ChunkedCDF(int xMin, int xMax, ChunkEvaluator evaluateChunk, DirectEvaluator evaluate)
+: _xMin(xMin), _xMax(xMax), _chunkCount(0), _normalizer(1.0), _evaluateChunk(std::move(evaluateChunk)),
+  _evaluate(std::move(evaluate))
+{
+    if (xMax < xMin)
+        return;
+
+    const size_t length = (size_t) (xMax - xMin) + 1;
+    _chunkCount = (length + ChunkLength - 1) / ChunkLength;
+    _chunks = make_unique<atomic<const double*>[]>(_chunkCount);
+    for (size_t chunk = 0; chunk < _chunkCount; ++chunk)
+        _chunks[chunk].store(nullptr, memory_order_relaxed);
+
+    // The first chunk holds the normalizer and is read by every use of the function, so it is settled up front,
+    // while the normalizer is still one.
+    double* values = EvaluateChunk(0);
+    if (values == nullptr)
+    {
+        _normalizer = _evaluate(xMin);
+        _chunks[0].store(Direct, memory_order_release);
+        return;
+    }
+
+    _normalizer = values[0];
+    for (size_t i = 0; i < ChunkSize(0); ++i)
+        values[i] /= _normalizer;
+    _chunks[0].store(values, memory_order_release);
+}
+
+ChunkedCDF::~ChunkedCDF()
+{
+    size_t storedBytes = 0;
+    for (size_t chunk = 0; chunk < _chunkCount; ++chunk)
+    {
+        const double* values = _chunks[chunk].load(memory_order_relaxed);
+        if (values == nullptr || values == Direct)
+            continue;
+        storedBytes += ChunkSize(chunk) * sizeof(double);
+        delete[] values;
+    }
+    memoryUse.fetch_sub(storedBytes, memory_order_relaxed);
+}
+
+size_t ChunkedCDF::ChunkSize(size_t chunk) const
+{
+    const size_t length = (size_t) (_xMax - _xMin) + 1;
+    return min(length - chunk * ChunkLength, (size_t) ChunkLength);
+}
+
+double* ChunkedCDF::EvaluateChunk(size_t chunk) const
+{
+    const size_t size = ChunkSize(chunk);
+    if (!charge(size * sizeof(double)))
+        return nullptr;
+
+    auto values = new double[size];
+    _evaluateChunk(_xMin + (int) (chunk * ChunkLength), span(values, size));
+    for (size_t i = 0; i < size; ++i)
+        values[i] /= _normalizer;
+    return values;
+}
+
+const double* ChunkedCDF::Materialize(size_t chunk) const
+{
+    lock_guard<mutex> lock(_mutex);
+    const double* values = _chunks[chunk].load(memory_order_acquire);
+    if (values == nullptr)
+    {
+        values = EvaluateChunk(chunk);
+        if (values == nullptr)
+            values = Direct;
+        _chunks[chunk].store(values, memory_order_release);
+    }
+    return values;
+}
+
+void set_cdf_memory_budget(size_t bytes)
+{
+    memoryBudget.store(bytes, memory_order_relaxed);
+}
+
+size_t cdf_memory_budget()
+{
+    return memoryBudget.load(memory_order_relaxed);
+}
+
+size_t cdf_memory_use()
+{
+    return memoryUse.load(memory_order_relaxed);
+}
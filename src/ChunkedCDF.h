@@ -0,0 +1,85 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+
+/**
+ * Values of a cumulative distribution function over the consecutive integers xMin, ..., xMax, materialized in chunks
+ * of ChunkLength values on their first access. Every stored chunk is charged against one memory budget shared by all
+ * the tables of the process, and a chunk that no longer fits in it is evaluated directly on every access instead, so
+ * the memory use of all the tables together is bounded by the budget instead of by their number and ranges. Whether
+ * a chunk is stored is settled on its first access and never changes afterwards, so concurrent readers of a table
+ * always obtain the same values, and stored chunks are read without locking.
+ * The values are divided by the one at xMin, so the function starts at one.
+ */
+class ChunkedCDF
+{
+public:
+    /// Evaluates the function at first + i into values[i], before the normalization.
+    using ChunkEvaluator = std::function<void(int first, std::span<double> values)>;
+
+    /// Evaluates the function at x, before the normalization, in the chunks that are not stored.
+    using DirectEvaluator = std::function<double(int x)>;
+
+    static constexpr int ChunkLength = 1 << 14;
+    static constexpr std::size_t DefaultMemoryBudget = std::size_t(64) << 20;
+
+private:
+    int _xMin, _xMax;
+    std::size_t _chunkCount;
+    double _normalizer;
+    ChunkEvaluator _evaluateChunk;
+    DirectEvaluator _evaluate;
+    std::unique_ptr<std::atomic<const double*>[]> _chunks;  // Null until the first access, Direct if not stored
+    mutable std::mutex _mutex;                              // Serializes the materialization of chunks
+
+    /// Marks the chunks that did not fit in the memory budget.
+    static const double Direct[1];
+
+    /// Stores a chunk if it fits in the memory budget, unless another thread settled it first.
+    const double* Materialize(std::size_t chunk) const;
+
+    /// Number of values of a chunk.
+    [[nodiscard]] std::size_t ChunkSize(std::size_t chunk) const;
+
+    /// Allocates and evaluates a chunk, if its size can be charged against the memory budget.
+    double* EvaluateChunk(std::size_t chunk) const;
+
+public:
+    /**
+     * @param xMin First value of the range.
+     * @param xMax Last value of the range.
+     * @param evaluateChunk Evaluates the stored chunks.
+     * @param evaluate Evaluates the values of the chunks that are not stored.
+     */
+    ChunkedCDF(int xMin, int xMax, ChunkEvaluator evaluateChunk, DirectEvaluator evaluate);
+    ~ChunkedCDF();
+
+    ChunkedCDF(const ChunkedCDF&) = delete;
+    ChunkedCDF& operator=(const ChunkedCDF&) = delete;
+
+    /// Value at x, for x from xMin to xMax.
+    [[nodiscard]] double Get(int x) const
+    {
+        const auto offset = (std::size_t) (x - _xMin);
+        const std::size_t chunk = offset / ChunkLength;
+        const double* values = _chunks[chunk].load(std::memory_order_acquire);
+        if (values == nullptr)
+            values = Materialize(chunk);
+        if (values == Direct)
+            return _evaluate(x) / _normalizer;
+        return values[offset % ChunkLength];
+    }
+};
+
+/// Sets the memory budget shared by all the CDF tables. Must be called before fitting starts.
+void set_cdf_memory_budget(std::size_t bytes);
+
+/// Memory budget shared by all the CDF tables, ChunkedCDF::DefaultMemoryBudget unless it was set.
+std::size_t cdf_memory_budget();
+
+/// Bytes of the chunks stored by the CDF tables that currently exist.
+std::size_t cdf_memory_use();
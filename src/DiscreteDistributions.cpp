@@ -1,8 +1,18 @@
 #include "../include/DiscreteDistributions.h"
 #include "../include/TestStatistics.h"
+#include "ChunkedCDF.h"
 #include "Zeta.h"
+#include "ZetaCache.h"
+#include "ZetaSurrogate.h"
+#include "ZetaTable.h"
+#include "TailSummary.h"
+#include "BoundScanner.h"
+#include "SharedThreadPool.h"
 #include "VectorUtilities.h"
+#include "Optimization.h"
 #include <iostream>
+#include <span>
+#include <tuple>
 using namespace std;
 
 /******************************************
@@ -20,29 +30,36 @@ DiscreteEmpiricalDistribution::DiscreteEmpiricalDistribution(const vector<int>&
     // Assign and precalculate
     _xMin = xMin;
     _xMax = xMax;
-    PrecalculateCDF(sortedTailSample);
+    PrecalculateCDF(std::move(sortedTailSample));
 }
 
-void DiscreteEmpiricalDistribution::PrecalculateCDF(const vector<int>& sortedTailSample)
+void DiscreteEmpiricalDistribution::PrecalculateCDF(vector<int> sortedTailSample)
 {
-    if (_xMax > _xMin)
+    // The CDF at x is the fraction of the tail sample greater or equal than x. Chunks are filled walking along the
+    // sample, and the values past them are found by binary search.
+    const auto sample = make_shared<const vector<int>>(std::move(sortedTailSample));
+    const auto sampleSize = (double) sample->size();
+    const auto fillChunk = [sample, sampleSize](int first, span<double> values)
     {
-        const auto sortedTailSampleSize = (double) sortedTailSample.size();
-        _cdf.reserve(_xMax - _xMin + 1);
-
-        _cdf.push_back(1.0);
-        for (int x = _xMin; x < _xMax; ++x)
+        auto lower = (size_t) VectorUtilities::IndexOf(*sample, first - 1);
+        for (size_t i = 0; i < values.size(); ++i)
         {
-            const double foundIndex = VectorUtilities::IndexOf(sortedTailSample, x);
-            const double cdfVal = 1.0 - (foundIndex / sortedTailSampleSize);
-            _cdf.push_back(cdfVal);
+            while (lower < sample->size() && (*sample)[lower] < first + (int) i)
+                lower++;
+            values[i] = 1.0 - ((double) lower / sampleSize);
         }
-    }
+    };
+    const auto evaluate = [sample, sampleSize](int x)
+    {
+        return 1.0 - ((double) VectorUtilities::IndexOf(*sample, x - 1) / sampleSize);
+    };
+    _cdf = make_shared<const ChunkedCDF>(_xMin, _xMax, fillChunk, evaluate);
 }
+
 double DiscreteEmpiricalDistribution::GetCDF(int x) const
 {
     if (x >= _xMin && x <= _xMax)
-        return _cdf[x - _xMin];
+        return _cdf->Get(x);
     else if (x < _xMin)
         return 1.0;
     else
@@ -60,236 +77,641 @@ DiscretePowerLawDistribution::DiscretePowerLawDistribution(const DiscretePowerLa
     _xMax = other._xMax;
     _state = other._state;
     _sampleSize = other._sampleSize;
+    _smallestInterval = other._smallestInterval;
+    _minTailSize = other._minTailSize;
     _alphaPrecision = other._alphaPrecision;
+    _alphaEstimator = other._alphaEstimator;
+    _lowerBoundSearch = other._lowerBoundSearch;
     _ksStatistic = other._ksStatistic;
     _distributionType = other._distributionType;
     _cdf = other._cdf;
 }
 
 DiscretePowerLawDistribution::DiscretePowerLawDistribution(const vector<int> &sampleData, int xParameter, double alphaPrecision,
-                                                           DistributionType distributionType)
+                                                           DistributionType distributionType, AlphaEstimator alphaEstimator)
+: DiscretePowerLawDistribution(sampleData, TailSummary(sampleData), xParameter, alphaPrecision, distributionType, alphaEstimator)
 {
-    _state = InputValidator(sampleData, xParameter, distributionType);
+}
+
+DiscretePowerLawDistribution::DiscretePowerLawDistribution(const vector<int> &sampleData, const TailSummary &summary,
+                                                           int xParameter, double alphaPrecision,
+                                                           DistributionType distributionType, AlphaEstimator alphaEstimator)
+{
+    _state = InputValidator(summary, xParameter, distributionType);
     _alphaPrecision = alphaPrecision;
+    _alphaEstimator = alphaEstimator;
+    _lowerBoundSearch = LowerBoundSearch::FirstLocalMinimum;
+    _smallestInterval = DefaultSmallestInterval;
+    _minTailSize = DefaultMinTailSize;
     _distributionType = distributionType;
 
     if (_state == DistributionState::Valid)
     {
         if (distributionType == DistributionType::LeftBounded)
-        {
-            _xMin = xParameter;
-            _xMax = VectorUtilities::Max(sampleData);
-            _alpha = EstimateAlpha(sampleData, _xMin, alphaPrecision);
-            _sampleSize = VectorUtilities::NumberOfGreaterOrEqual(sampleData, _xMin);
-        }
-        else if (distributionType == DistributionType::RightBounded)
-        {
-            _xMin = 1;
-            _xMax = xParameter;
-            _alpha = EstimateAlpha(sampleData, _xMin, _xMax, alphaPrecision);
-            _sampleSize = VectorUtilities::NumberOfLowerOrEqual(sampleData, _xMax);
-        }
-
-        PrecalculateCDF();
-        _ksStatistic = CalculateKSStatistic(sampleData);
+            AssignParameters(sampleData, summary, xParameter, summary.Max(),
+                             EstimateAlpha(summary, xParameter, alphaPrecision, alphaEstimator));
+        else
+            AssignParameters(sampleData, summary, 1, xParameter,
+                             EstimateAlpha(summary, 1, xParameter, alphaPrecision, alphaEstimator));
     }
 }
 
+DiscretePowerLawDistribution::DiscretePowerLawDistribution(const vector<int> &sampleData, int xMin, int xMax,
+                                                           double alphaPrecision, AlphaEstimator alphaEstimator)
+: DiscretePowerLawDistribution(sampleData, TailSummary(sampleData), xMin, xMax, alphaPrecision, alphaEstimator)
+{
+}
+
+DiscretePowerLawDistribution::DiscretePowerLawDistribution(const vector<int> &sampleData, const TailSummary &summary,
+                                                           int xMin, int xMax, double alphaPrecision,
+                                                           AlphaEstimator alphaEstimator)
+{
+    _state = InputValidator(summary, xMin, xMax);
+    _alphaPrecision = alphaPrecision;
+    _alphaEstimator = alphaEstimator;
+    _lowerBoundSearch = LowerBoundSearch::FirstLocalMinimum;
+    _smallestInterval = DefaultSmallestInterval;
+    _minTailSize = DefaultMinTailSize;
+    _distributionType = DistributionType::DoublyBounded;
+
+    if (_state == DistributionState::Valid)
+        AssignParameters(sampleData, summary, xMin, xMax,
+                         EstimateAlpha(summary, xMin, xMax, alphaPrecision, alphaEstimator));
+}
+
+void DiscretePowerLawDistribution::AssignParameters(const vector<int> &sampleData, const TailSummary &summary,
+                                                    int xMin, int xMax, double alpha)
+{
+    _xMin = xMin;
+    _xMax = xMax;
+    _sampleSize = summary.NumberInRange(xMin, xMax);
+    _alpha = alpha;
+
+    PrecalculateCDF();
+    _ksStatistic = CalculateKSStatistic(sampleData, summary);
+}
+
 DiscretePowerLawDistribution::DiscretePowerLawDistribution(const vector<int> &sampleData, double alphaPrecision,
-                                                           DistributionType distributionType, int smallestInterval)
+                                                           DistributionType distributionType, int smallestInterval,
+                                                           AlphaEstimator alphaEstimator, RuntimeMode runtimeMode,
+                                                           LowerBoundSearch lowerBoundSearch, int minTailSize)
 {
-    _state = InputValidator(sampleData);
+    _state = InputValidator(sampleData, minTailSize);
     _alphaPrecision = alphaPrecision;
+    _alphaEstimator = alphaEstimator;
+    _lowerBoundSearch = lowerBoundSearch;
+    _smallestInterval = smallestInterval;
+    _minTailSize = minTailSize;
     _distributionType = distributionType;
 
     if (_state == DistributionState::Valid)
     {
+        const TailSummary summary(sampleData);
         if (distributionType == DistributionType::LeftBounded)
         {
-            _xMin = EstimateLowerBound(sampleData, alphaPrecision);
-            _xMax = VectorUtilities::Max(sampleData);
-            _alpha = EstimateAlpha(sampleData, _xMin, alphaPrecision);
-            _sampleSize = VectorUtilities::NumberOfGreaterOrEqual(sampleData, _xMin);
+            _xMin = EstimateLowerBound(summary, alphaPrecision, alphaEstimator, runtimeMode, lowerBoundSearch,
+                                       minTailSize);
+            if (_xMin == 0)
+            {
+                _state = DistributionState::InvalidInput;
+                return;
+            }
+            _xMax = summary.Max();
+            _alpha = EstimateAlpha(summary, _xMin, alphaPrecision, alphaEstimator);
+            _sampleSize = summary.NumberOfGreaterOrEqual(_xMin);
         }
         else if (distributionType == DistributionType::RightBounded)
         {
             _xMin = 1;
-            _xMax = EstimateUpperBound(sampleData, alphaPrecision, smallestInterval);
-            _alpha = EstimateAlpha(sampleData, _xMin, _xMax,alphaPrecision);
-            _sampleSize = VectorUtilities::NumberOfLowerOrEqual(sampleData, _xMax);
+            _xMax = EstimateUpperBound(summary, alphaPrecision, smallestInterval, alphaEstimator, runtimeMode);
+            _alpha = EstimateAlpha(summary, _xMin, _xMax, alphaPrecision, alphaEstimator);
+            _sampleSize = summary.NumberOfLowerOrEqual(_xMax);
+        }
+        else if (distributionType == DistributionType::DoublyBounded)
+        {
+            tie(_xMin, _xMax) = EstimateBounds(summary, alphaPrecision, smallestInterval, alphaEstimator, runtimeMode,
+                                               minTailSize);
+            if (_xMin == 0)
+            {
+                _state = DistributionState::InvalidInput;
+                return;
+            }
+            _alpha = EstimateAlpha(summary, _xMin, _xMax, alphaPrecision, alphaEstimator);
+            _sampleSize = summary.NumberInRange(_xMin, _xMax);
         }
 
         PrecalculateCDF();
-        _ksStatistic = CalculateKSStatistic(sampleData);
+        _ksStatistic = CalculateKSStatistic(sampleData, summary);
     }
 }
 
-DistributionState DiscretePowerLawDistribution::InputValidator(const vector<int> &data)
+DistributionState DiscretePowerLawDistribution::InputValidator(const vector<int> &data, int minTailSize)
 {
-    return !data.empty() ? DistributionState::Valid : DistributionState::NoInput;
+    if (data.empty())
+        return DistributionState::NoInput;
+
+    if (minTailSize < 1 || minTailSize > (int) data.size())
+        return DistributionState::InvalidInput;
+
+    return DistributionState::Valid;
 }
 
-DistributionState DiscretePowerLawDistribution::InputValidator(const vector<int> &data, int xParameter, DistributionType distributionType)
+DistributionState DiscretePowerLawDistribution::InputValidator(const TailSummary &summary, int xParameter,
+                                                              DistributionType distributionType)
 {
-    if (data.empty())
+    if (summary.IsEmpty())
         return DistributionState::NoInput;
 
     if (distributionType == DistributionType::LeftBounded)
     {
-        int maxElement = VectorUtilities::Max(data);
+        int maxElement = summary.Max();
         if (xParameter >= maxElement)
             return DistributionState::InvalidInput;
     }
     else if (distributionType == DistributionType::RightBounded)
     {
-        int minElement = VectorUtilities::Min(data);
+        int minElement = summary.Min();
         if (xParameter <= minElement)
             return DistributionState::InvalidInput;
     }
+    else // The doubly bounded model needs both bounds
+        return DistributionState::InvalidInput;
+
+    return DistributionState::Valid;
+}
+
+DistributionState DiscretePowerLawDistribution::InputValidator(const TailSummary &summary, int xMin, int xMax)
+{
+    if (summary.IsEmpty())
+        return DistributionState::NoInput;
+
+    if (xMin < 1 || xMin >= xMax || summary.NumberInRange(xMin, xMax) == 0)
+        return DistributionState::InvalidInput;
 
     return DistributionState::Valid;
 }
 
 void DiscretePowerLawDistribution::PrecalculateCDF()
 {
-    _cdf.reserve(_xMax - _xMin + 1);
-    for (int x = _xMin; x <= _xMax; ++x)
+    const double alpha = _alpha;
+    if (_distributionType != DistributionType::LeftBounded)
     {
-        double cdfValue = (_distributionType == DistributionType::LeftBounded) ?
-                CalculateCDF(x, _alpha, _xMin) : CalculateCDF(x, _alpha, _xMin, _xMax);
-        _cdf.push_back(cdfValue);
+        // The CDF of the bounded models is a ratio of partial sums of x^-alpha. Every chunk accumulates them from its
+        // upper end downwards, one term per value, starting from the sum past the chunk, which is zero for the chunk
+        // of xMax and a difference of zeta values otherwise. The powers are evaluated together by the vector kernel,
+        // and the rounding error of every addition is carried apart, so the sums stay accurate over long ranges.
+        const int xMax = _xMax;
+        const double tailZeta = cached_hurwitz_zeta(alpha, 1.0 + xMax);
+        const auto fillChunk = [alpha, xMax, tailZeta](int first, span<double> values)
+        {
+            const long long end = first + (long long) values.size();
+            const double partialSum = (end > xMax) ? 0.0 : cached_hurwitz_zeta(alpha, (double) end) - tailZeta;
+            inverse_power_suffix_sums(alpha, first, partialSum, values);
+        };
+        const auto evaluate = [alpha, tailZeta](int x) { return cached_hurwitz_zeta(alpha, x) - tailZeta; };
+        _cdf = make_shared<const ChunkedCDF>(_xMin, _xMax, fillChunk, evaluate);
+        return;
     }
+
+    // The left bounded CDF is zeta(alpha, x) / zeta(alpha, xMin), over consecutive arguments, and the first value is
+    // the normalizer. Grid exponents read the leading arguments from the zeta table when one is in use.
+    const auto fillChunk = [alpha](int first, span<double> values)
+    {
+        const ZetaTable* table = shared_zeta_table();
+        const int tabulated = table != nullptr ? table->ReadArguments(alpha, first, values) : 0;
+        real_hurwitz_zeta_range(alpha, first + tabulated, values.subspan(tabulated));
+    };
+    const auto evaluate = [alpha](int x) { return cached_hurwitz_zeta(alpha, x); };
+    _cdf = make_shared<const ChunkedCDF>(_xMin, _xMax, fillChunk, evaluate);
 }
 
-double DiscretePowerLawDistribution::EstimateAlpha(const vector<int> &data, int xMin, double precision)
+vector<double> DiscretePowerLawDistribution::AlphaGrid(double precision)
 {
     const int div = static_cast<int>(1.0 / precision);
     const int lowerIntAlpha = static_cast<int>(1.50 * div);
     const int upperIntAlpha = static_cast<int>(3.51 * div);
 
-    vector<double> logLikelihoods;
-    logLikelihoods.reserve(upperIntAlpha - lowerIntAlpha);
-
+    vector<double> alphaGrid;
+    alphaGrid.reserve(upperIntAlpha - lowerIntAlpha);
     for (int intAlpha = lowerIntAlpha; intAlpha < upperIntAlpha; intAlpha++)
-    {
-        const double alpha = (double) intAlpha / div;
-        logLikelihoods.push_back(CalculateLogLikelihoodLeftBounded(data, alpha, xMin));
-    }
+        alphaGrid.push_back((double) intAlpha / div);
 
-    const int maxLikelihoodIntAlpha = VectorUtilities::IndexOfMax(logLikelihoods) + lowerIntAlpha;
-    return (double) maxLikelihoodIntAlpha / div;
+    return alphaGrid;
 }
 
-double DiscretePowerLawDistribution::EstimateAlpha(const vector<int> &data, int xMin, int xMax, double precision)
+pair<double, double> DiscretePowerLawDistribution::AlphaRange(double precision, AlphaEstimator estimator)
 {
-    const int div = static_cast<int>(1.0 / precision);
-    const int lowerIntAlpha = static_cast<int>(1.50 * div);
-    const int upperIntAlpha = static_cast<int>(3.51 * div);
+    if (estimator != AlphaEstimator::Grid)
+        return { AlphaLowerLimit, AlphaUpperLimit };
 
-    vector<double> logLikelihoods;
-    logLikelihoods.reserve(upperIntAlpha - lowerIntAlpha);
+    const vector<double> alphaGrid = AlphaGrid(precision);
+    return { alphaGrid.front(), alphaGrid.back() };
+}
 
-    for (int intAlpha = lowerIntAlpha; intAlpha < upperIntAlpha; intAlpha++)
+/// Normalizing constant zeta(alpha, xMin) - zeta(alpha, xMax + 1) of the bounded models and its derivatives.
+HurwitzZetaDerivatives bounded_normalizer_derivatives(double alpha, int xMin, int xMax)
+{
+    const HurwitzZetaDerivatives head = real_hurwitz_zeta_derivatives(alpha, xMin);
+    const HurwitzZetaDerivatives tail = real_hurwitz_zeta_derivatives(alpha, 1 + xMax);
+    return { head.value - tail.value, head.first - tail.first, head.second - tail.second };
+}
+
+/// Fisher information of one observation, the variance of -ln(x) under the model: (ln Z)'' = Z''/Z - (Z'/Z)^2.
+double fisher_information(const HurwitzZetaDerivatives &normalizer)
+{
+    const double logFirst = normalizer.first / normalizer.value;
+    return normalizer.second / normalizer.value - logFirst * logFirst;
+}
+
+/// First and second derivatives in alpha of the log-likelihood -n ln Z(alpha) - alpha * sum(ln x).
+pair<double, double> log_likelihood_derivatives(double n, double logXSum, const HurwitzZetaDerivatives &normalizer)
+{
+    return { - n * normalizer.first / normalizer.value - logXSum, - n * fisher_information(normalizer) };
+}
+
+/// Alpha of the continuous power law fitted to x - 1/2, which starts the Newton iteration close to the solution.
+double continuous_alpha_approximation(double n, double logXSum, int xMin)
+{
+    return 1.0 + n / (logXSum - n * log(xMin - 0.5));
+}
+
+/// Index of the grid value closest to alpha.
+size_t grid_index_of(const vector<double> &alphaGrid, double alpha)
+{
+    const auto it = lower_bound(alphaGrid.begin(), alphaGrid.end(), alpha);
+    if (it == alphaGrid.end())
+        return alphaGrid.size() - 1;
+    if (it != alphaGrid.begin() && alpha - *(it - 1) < *it - alpha)
+        return it - alphaGrid.begin() - 1;
+    return it - alphaGrid.begin();
+}
+
+vector<double> DiscretePowerLawDistribution::LogLikelihoodProfile(double n, double logXSum, const vector<double> &alphaGrid,
+                                                                  const vector<double> &normalizers)
+{
+    vector<double> logLikelihoods(alphaGrid.size());
+    for (size_t i = 0; i < alphaGrid.size(); ++i)
+        logLikelihoods[i] = - n * log(normalizers[i]) - alphaGrid[i] * logXSum;
+
+    return logLikelihoods;
+}
+
+template<typename LogLikelihood>
+double DiscretePowerLawDistribution::MaximizeLogLikelihood(const LogLikelihood& logLikelihood, double precision,
+                                                           AlphaEstimator estimator, double alphaGuess)
+{
+    if (estimator == AlphaEstimator::Brent)
+    {
+        // The log-likelihood is concave in alpha, so a bracket around the guess holds the maximum unless the search
+        // ends against one of its inner ends. In that case the full range is searched. Brent's method stops within
+        // twice its tolerance, which has a relative part, so the margin is never smaller than a tenth of the radius
+        // and always covers the relative part.
+        if (!isnan(alphaGuess))
+        {
+            const double lower = max(AlphaLowerLimit, alphaGuess - WarmStartRadius);
+            const double upper = min(AlphaUpperLimit, alphaGuess + WarmStartRadius);
+            const double margin = max(precision, 0.1 * WarmStartRadius) +
+                                  2.0 * sqrt(numeric_limits<double>::epsilon()) * upper;
+            const double alpha = Optimization::BrentMaximize(logLikelihood, lower, upper, 0.5 * precision);
+            if ((lower == AlphaLowerLimit || alpha - lower > margin) &&
+                (upper == AlphaUpperLimit || upper - alpha > margin))
+                return alpha;
+        }
+
+        return Optimization::BrentMaximize(logLikelihood, AlphaLowerLimit, AlphaUpperLimit, 0.5 * precision);
+    }
+
+    const vector<double> alphaGrid = AlphaGrid(precision);
+    if (!isnan(alphaGuess))
     {
-        const double alpha = (double) intAlpha / div;
-        logLikelihoods.push_back(CalculateLogLikelihoodRightBounded(data, alpha, xMax));
+        // Climb the concave log-likelihood from the guess instead of evaluating the whole grid.
+        const auto gridLogLikelihood = [&](size_t i) { return logLikelihood(alphaGrid[i]); };
+        return alphaGrid[Optimization::HillClimbMaximize(gridLogLikelihood, alphaGrid.size(),
+                                                         grid_index_of(alphaGrid, alphaGuess))];
     }
 
-    const int maxLikelihoodIntAlpha = VectorUtilities::IndexOfMax(logLikelihoods) + lowerIntAlpha;
-    return (double) maxLikelihoodIntAlpha / div;
+    vector<double> logLikelihoods;
+    logLikelihoods.reserve(alphaGrid.size());
+    for (double alpha : alphaGrid)
+        logLikelihoods.push_back(logLikelihood(alpha));
+
+    return alphaGrid[VectorUtilities::IndexOfMax(logLikelihoods)];
 }
 
-int DiscretePowerLawDistribution::EstimateLowerBound(const vector<int> &data, double precision)
+double DiscretePowerLawDistribution::EstimateAlpha(const TailSummary &summary, int xMin, double precision,
+                                                   AlphaEstimator estimator, double alphaGuess)
 {
-    // Estimate xMin via finding the first local minima of KS test-statistic
-    const int minElement = VectorUtilities::Min(data);
-    const int maxElement = VectorUtilities::Max(data);
+    if (estimator == AlphaEstimator::Newton)
+    {
+        const auto n = (double) summary.NumberOfGreaterOrEqual(xMin);
+        const double logXSum = summary.LogSumOfGreaterOrEqual(xMin);
+        const auto derivatives = [&](double alpha)
+        {
+            return log_likelihood_derivatives(n, logXSum, real_hurwitz_zeta_derivatives(alpha, xMin));
+        };
+        const double start = isnan(alphaGuess) ? continuous_alpha_approximation(n, logXSum, xMin) : alphaGuess;
+        return Optimization::NewtonMaximize(derivatives, AlphaLowerLimit, AlphaUpperLimit, start, 0.5 * precision);
+    }
 
-    double minKsStatistic = numeric_limits<double>::infinity();
-    int xMinEstimator = 0;
-    for (int x = minElement; x < maxElement; ++x)
+    if (estimator == AlphaEstimator::Grid && isnan(alphaGuess))
     {
-        const DiscretePowerLawDistribution model(data, x, precision,
-                                                 DistributionType::LeftBounded);
-        const double ksStatistic = model.GetKSStatistic();
-        if (ksStatistic < minKsStatistic)
-            minKsStatistic = ksStatistic;
-        else
+        // Evaluate the normalizing constants of the whole grid in one batch.
+        const vector<double> alphaGrid = AlphaGrid(precision);
+        vector<double> zetaValues;
+        real_hurwitz_zeta_batch(alphaGrid, xMin, zetaValues);
+        return EstimateAlpha(summary, xMin, alphaGrid, zetaValues);
+    }
+
+    // The surrogate of ln zeta(alpha, xMin) replaces the exact normalizing constant when it is in use and accurate,
+    // within its interval. The ends of coarse grids, such as 1.4985 at precision 0.003, are evaluated exactly.
+    LogZetaSurrogate surrogate;
+    LogZetaSurrogateStore* surrogates = shared_zeta_surrogates();
+    if (surrogates != nullptr && surrogates->Find(xMin, surrogate))
+    {
+        const auto n = (double) summary.NumberOfGreaterOrEqual(xMin);
+        const double logXSum = summary.LogSumOfGreaterOrEqual(xMin);
+        const auto logLikelihood = [&](double alpha)
         {
-            xMinEstimator = x - 1;
-            break;
-        }
+            if (alpha < LogZetaSurrogate::LowerExponent || alpha > LogZetaSurrogate::UpperExponent)
+                return CalculateLogLikelihoodLeftBounded(summary, alpha, xMin);
+            return - n * surrogate.Evaluate(alpha) - alpha * logXSum;
+        };
+        return MaximizeLogLikelihood(logLikelihood, precision, estimator, alphaGuess);
     }
 
-    return clamp(xMinEstimator, 1, maxElement);
+    const auto logLikelihood = [&](double alpha) { return CalculateLogLikelihoodLeftBounded(summary, alpha, xMin); };
+    return MaximizeLogLikelihood(logLikelihood, precision, estimator, alphaGuess);
 }
-int DiscretePowerLawDistribution::EstimateUpperBound(const vector<int> &data, double precision, int smallestInterval)
+
+double DiscretePowerLawDistribution::EstimateAlpha(const TailSummary &summary, int xMin, const vector<double> &alphaGrid,
+                                                   const vector<double> &zetaValues, double alphaGuess)
 {
-    // Estimate xMin via KS minimization.
-    const int minElement = 1 + smallestInterval;
-    const int maxElement = VectorUtilities::Max(data);
+    const auto n = (double) summary.NumberOfGreaterOrEqual(xMin);
+    const double logXSum = summary.LogSumOfGreaterOrEqual(xMin);
 
-    vector<double> ksValues;
-    ksValues.reserve(maxElement - minElement);
-    for (int x = minElement; x < maxElement; ++x)
+    if (!isnan(alphaGuess))
     {
-        const DiscretePowerLawDistribution model(data, x, precision,
-                                                 DistributionType::RightBounded);
-        ksValues.push_back(model.GetKSStatistic());
+        const auto gridLogLikelihood = [&](size_t i) { return - n * log(zetaValues[i]) - alphaGrid[i] * logXSum; };
+        return alphaGrid[Optimization::HillClimbMaximize(gridLogLikelihood, alphaGrid.size(),
+                                                         grid_index_of(alphaGrid, alphaGuess))];
     }
 
-    const int xMax = VectorUtilities::IndexOfMin(ksValues) + minElement;
-    return xMax;
+    return alphaGrid[VectorUtilities::IndexOfMax(LogLikelihoodProfile(n, logXSum, alphaGrid, zetaValues))];
 }
 
-double DiscretePowerLawDistribution::CalculateLogLikelihoodLeftBounded(const vector<int> &data, double alpha, int xMin)
+double DiscretePowerLawDistribution::EstimateAlpha(const TailSummary &summary, int xMin, int xMax,
+                                                   const vector<double> &alphaGrid, const vector<double> &normalizers,
+                                                   double alphaGuess)
 {
-    const auto n = (double) VectorUtilities::NumberOfGreaterOrEqual(data, xMin);
+    const auto n = (double) summary.NumberInRange(xMin, xMax);
+    const double logXSum = summary.LogSumInRange(xMin, xMax);
 
-    double logXSum = 0;
-    for (double x: data)
-        if (x >= xMin)
-            logXSum += log(x);
+    if (!isnan(alphaGuess))
+    {
+        const auto gridLogLikelihood = [&](size_t i) { return - n * log(normalizers[i]) - alphaGrid[i] * logXSum; };
+        return alphaGrid[Optimization::HillClimbMaximize(gridLogLikelihood, alphaGrid.size(),
+                                                         grid_index_of(alphaGrid, alphaGuess))];
+    }
 
-    return - n * log(real_hurwitz_zeta(alpha, xMin)) - alpha * logXSum;
+    return alphaGrid[VectorUtilities::IndexOfMax(LogLikelihoodProfile(n, logXSum, alphaGrid, normalizers))];
 }
 
-double DiscretePowerLawDistribution::CalculateLogLikelihoodRightBounded(const vector<int> &data, double alpha, int xMax)
+double DiscretePowerLawDistribution::EstimateAlpha(const TailSummary &summary, int xMin, int xMax, double precision,
+                                                   AlphaEstimator estimator, double alphaGuess)
 {
-    const auto n = (double) VectorUtilities::NumberOfLowerOrEqual(data, xMax);
+    if (estimator == AlphaEstimator::Newton)
+    {
+        const auto n = (double) summary.NumberInRange(xMin, xMax);
+        const double logXSum = summary.LogSumInRange(xMin, xMax);
+        const auto derivatives = [&](double alpha)
+        {
+            return log_likelihood_derivatives(n, logXSum, bounded_normalizer_derivatives(alpha, xMin, xMax));
+        };
+        const double start = isnan(alphaGuess) ? continuous_alpha_approximation(n, logXSum, xMin) : alphaGuess;
+        return Optimization::NewtonMaximize(derivatives, AlphaLowerLimit, AlphaUpperLimit, start, 0.5 * precision);
+    }
 
-    double logXSum = 0;
-    for (double x: data)
-        if (x >= 1 && x <= xMax)
-            logXSum += log(x);
+    if (estimator == AlphaEstimator::Grid && isnan(alphaGuess))
+    {
+        // Evaluate the normalizing constants of the whole grid in two batches.
+        const vector<double> alphaGrid = AlphaGrid(precision);
+        vector<double> normalizers, tailZetaValues;
+        real_hurwitz_zeta_batch(alphaGrid, xMin, normalizers);
+        real_hurwitz_zeta_batch(alphaGrid, 1 + xMax, tailZetaValues);
+        for (size_t i = 0; i < alphaGrid.size(); ++i)
+            normalizers[i] -= tailZetaValues[i];
+
+        return EstimateAlpha(summary, xMin, xMax, alphaGrid, normalizers);
+    }
 
-    return - n * log(real_hurwitz_zeta(alpha, 1) - real_hurwitz_zeta(alpha, 1 + xMax)) - alpha * logXSum;
+    const auto logLikelihood = [&](double alpha) { return CalculateLogLikelihoodBounded(summary, alpha, xMin, xMax); };
+    return MaximizeLogLikelihood(logLikelihood, precision, estimator, alphaGuess);
 }
 
-double DiscretePowerLawDistribution::CalculateCDF(int x, double alpha, int xMin)
+int DiscretePowerLawDistribution::EstimateLowerBound(const TailSummary &summary, double precision, AlphaEstimator estimator,
+                                                     RuntimeMode runtimeMode, LowerBoundSearch search, int minTailSize)
 {
-    if (x >= xMin)
+    // Estimate xMin via finding the first local minima, or the global minima, of KS test-statistic.
+    // The candidates are the distinct observed values, except the largest one, whose tail holds enough observations.
+    const vector<int>& values = summary.GetValues();
+    int candidateCount = summary.GetDistinctSize() - 1;
+    while (candidateCount > 0 && summary.NumberFromIndex(candidateCount - 1) < minTailSize)
+        candidateCount--;
+    if (candidateCount == 0)
+        return 0;
+
+    // Candidates are evaluated in waves of one block per thread, and the waves are reduced in order, so the scan
+    // can stop early and its result does not depend on the number of threads. The pruned global search uses waves
+    // of a fixed number of blocks instead.
+    const int blockCount = (search == LowerBoundSearch::GlobalMinimum) ?
+            PrunedScanWaveBlocks : scan_block_count(runtimeMode);
+    const int waveSize = blockCount * ScanBlockSize;
+    vector<LowerBoundScanner> scanners(blockCount, LowerBoundScanner(summary, precision, estimator));
+    vector<double> ksValues(waveSize);
+
+    double minKsStatistic = numeric_limits<double>::infinity();
+    int xMinEstimator = 0;
+    for (int waveStart = 0; waveStart < candidateCount; waveStart += waveSize)
     {
-        const double numerator = real_hurwitz_zeta(alpha, x);
-        const double denominator = real_hurwitz_zeta(alpha, xMin);
-        return numerator / denominator;
+        const int waveEnd = min(waveStart + waveSize, candidateCount);
+        const auto evaluateBlock = [&](int block)
+        {
+            // In the global search, candidates that can not improve the best KS statistic found so far are pruned.
+            // Pruned candidates report a value above that threshold, so the arg-min below is not affected.
+            // Blocks always start at a multiple of the block size, so the warm starts do not depend on the number of
+            // threads either.
+            double ksThreshold = numeric_limits<double>::infinity();
+            const int blockEnd = min(waveStart + (block + 1) * ScanBlockSize, waveEnd);
+            scanners[block].ResetWarmStart();
+            for (int i = waveStart + block * ScanBlockSize; i < blockEnd; ++i)
+            {
+                if (search == LowerBoundSearch::GlobalMinimum)
+                    ksThreshold = min(ksThreshold, minKsStatistic);
+
+                const double ksStatistic = scanners[block].Evaluate(values[i], ksThreshold).ksStatistic;
+                ksValues[i - waveStart] = ksStatistic;
+                if (search == LowerBoundSearch::GlobalMinimum)
+                    ksThreshold = min(ksThreshold, ksStatistic);
+            }
+        };
+        for_each_scan_block(blockCount, runtimeMode, evaluateBlock);
+
+        for (int i = waveStart; i < waveEnd; ++i)
+        {
+            const double ksStatistic = ksValues[i - waveStart];
+            if (ksStatistic < minKsStatistic)
+            {
+                minKsStatistic = ksStatistic;
+                xMinEstimator = values[i];
+            }
+            else if (search == LowerBoundSearch::FirstLocalMinimum)
+                return xMinEstimator;
+        }
     }
-    else
-        return 1.0;
+
+    return clamp(xMinEstimator, 1, summary.Max());
 }
 
-double DiscretePowerLawDistribution::CalculateCDF(int x, double alpha, int xMin, int xMax)
+int DiscretePowerLawDistribution::EstimateUpperBound(const TailSummary &summary, double precision, int smallestInterval,
+                                                     AlphaEstimator estimator, RuntimeMode runtimeMode)
 {
-    if (x >= xMin && x <= xMax)
+    // Estimate xMax via KS minimization.
+    const int minElement = 1 + smallestInterval;
+    const int maxElement = summary.Max();
+    const int candidateCount = max(maxElement - minElement, 0);
+
+    // Each candidate writes its own slot, and the arg-min is taken sequentially afterwards.
+    // Alpha is warm started from the previous candidate within chunks of fixed size, so the result does not depend
+    // on how the chunks are split between threads. Candidates whose KS walk exceeds the best value of their block
+    // are cut short, which only raises values that can not be the minimum.
+    vector<double> ksValues(candidateCount);
+    const int chunkCount = (candidateCount + ScanBlockSize - 1) / ScanBlockSize;
+    const int blockCount = min(scan_block_count(runtimeMode) * ScanBlockSize, max(chunkCount, 1));
+    const auto evaluateBlock = [&](int block)
     {
-        const double numerator = real_hurwitz_zeta(alpha, x) - real_hurwitz_zeta(alpha, 1 + xMax);
-        const double denominator = real_hurwitz_zeta(alpha, xMin) - real_hurwitz_zeta(alpha, 1 + xMax);
-        return numerator / denominator;
+        UpperBoundScanner scanner(summary, precision, estimator);
+        const int blockStart = (int) ((long long) chunkCount * block / blockCount) * ScanBlockSize;
+        const int blockEnd = min((int) ((long long) chunkCount * (block + 1) / blockCount) * ScanBlockSize,
+                                 candidateCount);
+        double ksThreshold = numeric_limits<double>::infinity();
+        for (int i = blockStart; i < blockEnd; ++i)
+        {
+            if (i % ScanBlockSize == 0)
+                scanner.ResetWarmStart();
+
+            ksValues[i] = scanner.Evaluate(minElement + i, ksThreshold).ksStatistic;
+            ksThreshold = min(ksThreshold, ksValues[i]);
+        }
+    };
+    for_each_scan_block(blockCount, runtimeMode, evaluateBlock);
+
+    const int xMax = VectorUtilities::IndexOfMin(ksValues) + minElement;
+    return xMax;
+}
+
+pair<int, int> DiscretePowerLawDistribution::EstimateBounds(const TailSummary &summary, double precision,
+                                                            int smallestInterval, AlphaEstimator estimator,
+                                                            RuntimeMode runtimeMode, int minTailSize)
+{
+    // Estimate xMin and xMax via the global minimum of the KS statistic over pairs of distinct values.
+    // Each xMin candidate is a row of xMax candidates that are at least smallestInterval above it and leave enough
+    // observations in the range. Both limits only grow with xMin, so the rows are found in one pass.
+    const vector<int>& values = summary.GetValues();
+    const int distinctSize = summary.GetDistinctSize();
+    vector<int> firstColumns(distinctSize, distinctSize);
+    vector<long long> rowOffsets(distinctSize + 1, 0);
+    int column = 0;
+    for (int row = 0; row < distinctSize; ++row)
+    {
+        if (values[row] >= 1)
+        {
+            column = max({ column, row + 1, summary.LowerBoundIndex(values[row] + smallestInterval) });
+            const int rowTailSize = summary.NumberFromIndex(row);
+            while (column < distinctSize && rowTailSize - summary.NumberFromIndex(column + 1) < minTailSize)
+                column++;
+            firstColumns[row] = column;
+        }
+        rowOffsets[row + 1] = rowOffsets[row] + (distinctSize - firstColumns[row]);
     }
-    else if (x < xMin)
-        return 1.0;
-    else
-        return 0.0;
+    const long long candidateCount = rowOffsets[distinctSize];
+    if (candidateCount == 0)
+        return { 0, 0 };
+
+    // Normalizing constants of every candidate are read from tables at the distinct values: one at coarse alpha
+    // levels for the KS lower bounds, and one at the whole grid for the grid estimator.
+    const DistinctValueZetaTable boundZetaTable(summary, JointBoundScanner::BoundAlphas(precision, estimator));
+    const DistinctValueZetaTable gridZetaTable(summary, (estimator == AlphaEstimator::Grid) ?
+                                                        AlphaGrid(precision) : vector<double>());
+
+    // The candidates are evaluated in row order, in waves of a fixed number of blocks that are reduced in order, as
+    // in the pruned xMin search. Candidates that can not improve the best KS statistic found so far are pruned, and
+    // report a value above it, so the result does not depend on the number of threads.
+    const long long waveSize = PrunedScanWaveBlocks * ScanBlockSize;
+    vector<JointBoundScanner> scanners(PrunedScanWaveBlocks,
+                                       JointBoundScanner(summary, boundZetaTable, gridZetaTable, precision, estimator));
+    vector<BoundPairCandidate> candidates(waveSize);
+
+    double minKsStatistic = numeric_limits<double>::infinity();
+    pair<int, int> bounds(summary.Min(), summary.Max());
+    for (long long waveStart = 0; waveStart < candidateCount; waveStart += waveSize)
+    {
+        const long long waveEnd = min(waveStart + waveSize, candidateCount);
+        const auto evaluateBlock = [&](int block)
+        {
+            const long long blockStart = waveStart + (long long) block * ScanBlockSize;
+            const long long blockEnd = min(blockStart + ScanBlockSize, waveEnd);
+            if (blockStart >= blockEnd)
+                return;
+
+            // Find the row of the first candidate of the block, then walk the rows. The warm start is reset at
+            // the start of the block and of every row.
+            int row = (int) (upper_bound(rowOffsets.begin(), rowOffsets.end(), blockStart) - rowOffsets.begin()) - 1;
+            double ksThreshold = minKsStatistic;
+            scanners[block].ResetWarmStart();
+            for (long long i = blockStart; i < blockEnd; ++i)
+            {
+                while (i >= rowOffsets[row + 1])
+                {
+                    row++;
+                    scanners[block].ResetWarmStart();
+                }
+
+                const int last = firstColumns[row] + (int) (i - rowOffsets[row]);
+                candidates[i - waveStart] = scanners[block].Evaluate(row, last, ksThreshold);
+                ksThreshold = min(ksThreshold, candidates[i - waveStart].ksStatistic);
+            }
+        };
+        for_each_scan_block(PrunedScanWaveBlocks, runtimeMode, evaluateBlock);
+
+        for (long long i = waveStart; i < waveEnd; ++i)
+        {
+            const BoundPairCandidate& candidate = candidates[i - waveStart];
+            if (candidate.ksStatistic < minKsStatistic)
+            {
+                minKsStatistic = candidate.ksStatistic;
+                bounds = { candidate.xMin, candidate.xMax };
+            }
+        }
+    }
+
+    return bounds;
+}
+
+double DiscretePowerLawDistribution::CalculateLogLikelihoodLeftBounded(const TailSummary &summary, double alpha, int xMin)
+{
+    const auto n = (double) summary.NumberOfGreaterOrEqual(xMin);
+    const double logXSum = summary.LogSumOfGreaterOrEqual(xMin);
+
+    return - n * log(real_hurwitz_zeta(alpha, xMin)) - alpha * logXSum;
+}
+
+double DiscretePowerLawDistribution::CalculateLogLikelihoodBounded(const TailSummary &summary, double alpha, int xMin,
+                                                                   int xMax)
+{
+    const auto n = (double) summary.NumberInRange(xMin, xMax);
+    const double logXSum = summary.LogSumInRange(xMin, xMax);
+
+    return - n * log(real_hurwitz_zeta(alpha, xMin) - real_hurwitz_zeta(alpha, 1 + xMax)) - alpha * logXSum;
 }
 
 int DiscretePowerLawDistribution::BinarySearch(int l, int r, double x) const
@@ -343,9 +765,9 @@ int DiscretePowerLawDistribution::GenerateRandomSample() const
         do
         {
             x1 = x2;
-            x2 = 2 * x1;
+            x2 = (x1 <= numeric_limits<int>::max() / 2) ? 2 * x1 : numeric_limits<int>::max();
             cdf = GetCDF(x2);
-        } while (cdf >= r);
+        } while (cdf >= r && x2 > x1);
 
         // Find exact solution in the interval by binary search
         return BinarySearch(x1, x2, r);
@@ -359,7 +781,9 @@ double DiscretePowerLawDistribution::GetPDF(int x) const
     if (_state == DistributionState::Valid)
     {
         double numerator = pow(x, -_alpha);
-        double denominator = real_hurwitz_zeta(_alpha, _xMin);
+        double denominator = cached_hurwitz_zeta(_alpha, _xMin);
+        if (_distributionType != DistributionType::LeftBounded)
+            denominator -= cached_hurwitz_zeta(_alpha, 1 + _xMax);
         return numerator / denominator;
     }
     else
@@ -371,7 +795,7 @@ double DiscretePowerLawDistribution::GetCDF(int x) const
     if (_state == DistributionState::Valid)
     {
         if (x >= _xMin && x <= _xMax)
-            return _cdf[x - _xMin];
+            return _cdf->Get(x);
         else if (x < _xMin)
             return 1.0;
         else
@@ -402,6 +826,26 @@ double DiscretePowerLawDistribution::GetAlphaPrecision() const
     return _alphaPrecision;
 }
 
+AlphaEstimator DiscretePowerLawDistribution::GetAlphaEstimator() const
+{
+    return _alphaEstimator;
+}
+
+LowerBoundSearch DiscretePowerLawDistribution::GetLowerBoundSearch() const
+{
+    return _lowerBoundSearch;
+}
+
+int DiscretePowerLawDistribution::GetSmallestInterval() const
+{
+    return _smallestInterval;
+}
+
+int DiscretePowerLawDistribution::GetMinTailSize() const
+{
+    return _minTailSize;
+}
+
 int DiscretePowerLawDistribution::GetXMin() const
 {
     if (_state == DistributionState::Valid)
@@ -428,15 +872,22 @@ double DiscretePowerLawDistribution::GetStandardError() const
 
 double DiscretePowerLawDistribution::GetStandardError(int sampleSize) const
 {
-    return (_alpha - 1.0) / (double) sampleSize;
+    // Inverse square root of the Fisher information of the sample, from the derivatives of the normalizing constant.
+    const HurwitzZetaDerivatives normalizer = (_distributionType == DistributionType::LeftBounded) ?
+            real_hurwitz_zeta_derivatives(_alpha, _xMin) : bounded_normalizer_derivatives(_alpha, _xMin, _xMax);
+    return 1.0 / sqrt(sampleSize * fisher_information(normalizer));
 }
 
 double DiscretePowerLawDistribution::GetLogLikelihood(const vector<int> &data) const
 {
-    return DiscretePowerLawDistribution::CalculateLogLikelihoodLeftBounded(data, _alpha, _xMin);
+    const TailSummary summary(data);
+    if (_distributionType == DistributionType::LeftBounded)
+        return CalculateLogLikelihoodLeftBounded(summary, _alpha, _xMin);
+    else
+        return CalculateLogLikelihoodBounded(summary, _alpha, _xMin, _xMax);
 }
 
-double DiscretePowerLawDistribution::CalculateKSStatistic(const vector<int> &data) const
+double DiscretePowerLawDistribution::CalculateKSStatistic(const vector<int> &data, const TailSummary &summary) const
 {
     DiscreteEmpiricalDistribution empirical(data, _xMin, _xMax);
 
@@ -444,12 +895,18 @@ double DiscretePowerLawDistribution::CalculateKSStatistic(const vector<int> &dat
     if (!StateIsValid())
         return numeric_limits<double>::infinity();
 
-    vector<double> diffs;
-    diffs.reserve(_xMax - _xMin + 1);
-    for (int x = _xMin; x <= _xMax; ++x)
-        diffs.push_back(abs(empirical.GetCDF(x) - GetCDF(x)));
+    // The empirical CDF is constant between an observed value and the next one, and the model one decreases, so the
+    // largest difference on each of these runs is found at one of its ends.
+    const auto difference = [&](int x) { return abs(empirical.GetCDF(x) - GetCDF(x)); };
+    const vector<int>& values = summary.GetValues();
+    double maxDiff = max(difference(_xMin), difference(_xMax));
+    for (int j = summary.LowerBoundIndex(_xMin); j < summary.UpperBoundIndex(_xMax); ++j)
+    {
+        maxDiff = max(maxDiff, difference(values[j]));
+        if (values[j] < _xMax)
+            maxDiff = max(maxDiff, difference(values[j] + 1));
+    }
 
-    const double maxDiff = VectorUtilities::Max(diffs);
     return maxDiff;
 }
 
@@ -476,6 +933,8 @@ std::string DiscretePowerLawDistribution::GetDistributionTypeStr() const
             return "Left bounded";
         case DistributionType::RightBounded:
             return "Right bounded";
+        case DistributionType::DoublyBounded:
+            return "Doubly bounded";
         default:
             return "<unknown>";
     }
@@ -497,8 +956,10 @@ SyntheticPowerLawGenerator::SyntheticPowerLawGenerator(const DiscretePowerLawDis
         _nonModelData = sampleData;
         if (model.GetDistributionType() == DistributionType::LeftBounded)
             VectorUtilities::RemoveGreaterOrEqual(_nonModelData, model.GetXMin());
-        else
+        else if (model.GetDistributionType() == DistributionType::RightBounded)
             VectorUtilities::RemoveLowerOrEqual(_nonModelData, model.GetXMax());
+        else
+            VectorUtilities::RemoveBetween(_nonModelData, model.GetXMin(), model.GetXMax());
 
         _modelSampleProbability = 1.0 - (double) _nonModelData.size() / (double) _sampleDataSize;
     }
@@ -540,17 +1001,31 @@ double SyntheticPowerLawGenerator::MeasureKsStatisticOfReplica() const
     const vector<int> &syntheticSample = GenerateSynthetic();
     const DistributionType distributionType = _powerLawDistribution.GetDistributionType();
     const double alphaPrecision = _powerLawDistribution.GetAlphaPrecision();
+    const AlphaEstimator alphaEstimator = _powerLawDistribution.GetAlphaEstimator();
 
     if (_mode == SyntheticGeneratorMode::SemiParametric)
     {
-        const DiscretePowerLawDistribution model(syntheticSample, alphaPrecision, distributionType);
+        const int smallestInterval = _powerLawDistribution.GetSmallestInterval();
+        const LowerBoundSearch lowerBoundSearch = _powerLawDistribution.GetLowerBoundSearch();
+        const int minTailSize = _powerLawDistribution.GetMinTailSize();
+        const DiscretePowerLawDistribution model(syntheticSample, alphaPrecision, distributionType,
+                                                 smallestInterval, alphaEstimator, RuntimeMode::SingleThread,
+                                                 lowerBoundSearch, minTailSize);
         return model.GetKSStatistic();
     }
     else // _mode == SyntheticGeneratorMode::FullParametric
     {
+        if (distributionType == DistributionType::DoublyBounded)
+        {
+            const DiscretePowerLawDistribution model(syntheticSample, _powerLawDistribution.GetXMin(),
+                                                     _powerLawDistribution.GetXMax(), alphaPrecision, alphaEstimator);
+            return model.GetKSStatistic();
+        }
+
         const int xParameter = (distributionType == DistributionType::LeftBounded) ?
                 _powerLawDistribution.GetXMin() : _powerLawDistribution.GetXMax();
-        const DiscretePowerLawDistribution model(syntheticSample, xParameter, alphaPrecision, distributionType);
+        const DiscretePowerLawDistribution model(syntheticSample, xParameter, alphaPrecision, distributionType,
+                                                 alphaEstimator);
         return model.GetKSStatistic();
     }
 }
\ No newline at end of file
@@ -0,0 +1,163 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <limits>
+
+namespace Optimization
+{
+    /// <summary>
+    /// Maximizes a unimodal function on the interval [a, b] with Brent's method, which combines
+    /// golden-section steps with parabolic interpolation. Converges to the given absolute tolerance.
+    /// </summary>
+    template<typename F> double BrentMaximize(const F& f, double a, double b, double tolerance)
+    {
+        const double goldenRatio = 0.5 * (3.0 - std::sqrt(5.0));
+        const double relativeTolerance = std::sqrt(std::numeric_limits<double>::epsilon());
+
+        double x = a + goldenRatio * (b - a);
+        double w = x, v = x;
+        double fx = -f(x);
+        double fw = fx, fv = fx;
+        double d = 0.0, e = 0.0;
+
+        while (true)
+        {
+            const double m = 0.5 * (a + b);
+            const double tol = relativeTolerance * std::abs(x) + tolerance;
+            const double tol2 = 2.0 * tol;
+
+            // Stopping criterion
+            if (std::abs(x - m) <= tol2 - 0.5 * (b - a))
+                break;
+
+            double p = 0.0, q = 0.0, r = 0.0;
+            if (std::abs(e) > tol)
+            {
+                // Fit a parabola through x, w and v
+                r = (x - w) * (fx - fv);
+                q = (x - v) * (fx - fw);
+                p = (x - v) * q - (x - w) * r;
+                q = 2.0 * (q - r);
+                if (q > 0.0)
+                    p = -p;
+                else
+                    q = -q;
+                r = e;
+                e = d;
+            }
+
+            if (std::abs(p) < std::abs(0.5 * q * r) && p > q * (a - x) && p < q * (b - x))
+            {
+                // Parabolic interpolation step
+                d = p / q;
+                const double u = x + d;
+                if ((u - a) < tol2 || (b - u) < tol2)
+                    d = (x < m) ? tol : -tol;
+            }
+            else
+            {
+                // Golden-section step
+                e = (x < m) ? b - x : a - x;
+                d = goldenRatio * e;
+            }
+
+            const double u = (std::abs(d) >= tol) ? x + d : x + (d > 0.0 ? tol : -tol);
+            const double fu = -f(u);
+
+            if (fu <= fx)
+            {
+                if (u < x)
+                    b = x;
+                else
+                    a = x;
+                v = w; fv = fw;
+                w = x; fw = fx;
+                x = u; fx = fu;
+            }
+            else
+            {
+                if (u < x)
+                    a = u;
+                else
+                    b = u;
+
+                if (fu <= fw || w == x)
+                {
+                    v = w; fv = fw;
+                    w = u; fw = fu;
+                }
+                else if (fu <= fv || v == x || v == w)
+                {
+                    v = u; fv = fu;
+                }
+            }
+        }
+
+        return x;
+    }
+
+    /// <summary>
+    /// Finds the first maximum of a unimodal sequence f(0), ..., f(size - 1) by climbing from the given start
+    /// index, so only the terms between the start and the maximum are evaluated.
+    /// </summary>
+    template<typename F> size_t HillClimbMaximize(const F& f, size_t size, size_t start)
+    {
+        size_t i = start;
+        double fi = f(i);
+
+        bool climbedUp = false;
+        while (i + 1 < size)
+        {
+            const double next = f(i + 1);
+            if (next <= fi)
+                break;
+            i++;
+            fi = next;
+            climbedUp = true;
+        }
+
+        // Ties are resolved towards the first index.
+        while (!climbedUp && i > 0)
+        {
+            const double previous = f(i - 1);
+            if (previous < fi)
+                break;
+            i--;
+            fi = previous;
+        }
+
+        return i;
+    }
+
+    /// <summary>
+    /// Maximizes a concave function on the interval [a, b] with Newton's method, starting from the given point.
+    /// derivatives(x) returns the first and second derivatives at x. Steps that leave the bracket of the root of the
+    /// first derivative are replaced by bisection, and the search stops once a step is below the tolerance.
+    /// </summary>
+    template<typename F> double NewtonMaximize(const F& derivatives, double a, double b, double start, double tolerance)
+    {
+        constexpr int maxIterations = 100;
+        double x = std::min(std::max(start, a), b);
+
+        for (int i = 0; i < maxIterations; ++i)
+        {
+            const auto [first, second] = derivatives(x);
+            if (first > 0.0)
+                a = x;
+            else
+                b = x;
+
+            double next = (second < 0.0) ? x - first / second : 0.5 * (a + b);
+            if (!(next > a && next < b))
+                next = 0.5 * (a + b);
+
+            const double step = std::abs(next - x);
+            x = next;
+            if (step < tolerance)
+                break;
+        }
+
+        return x;
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include "ThreadPool.h"
+
+/// Thread pool shared by the bootstrap replicas and the parallel bound scans.
+inline thread_pool& shared_thread_pool()
+{
+    static thread_pool pool;
+    return pool;
+}
+
+/**
+ * Calls loop(block) for every block in [0, blockCount) on the shared thread pool and waits for all of them.
+ * Must not be called from a task running on the shared pool.
+ */
+template<typename F> void parallel_for_blocks(int blockCount, const F& loop)
+{
+    const auto blockLoop = [&loop](int first, int last)
+    {
+        for (int block = first; block < last; ++block)
+            loop(block);
+    };
+    shared_thread_pool().parallelize_loop(0, blockCount, blockLoop, blockCount);
+}
@@ -0,0 +1,129 @@
+#include "TailSummary.h"
+#include "VectorUtilities.h"
+#include <cmath>
+using namespace std;
+
+TailSummary::TailSummary(const vector<int>& sampleData)
+{
+    vector<int> sortedSample = sampleData;
+    VectorUtilities::Sort(sortedSample);
+    _sampleSize = (int) sortedSample.size();
+
+    // Group the sorted sample in distinct values.
+    vector<double> logSums;
+    _lowerCounts.push_back(0);
+    for (int i = 0; i < _sampleSize;)
+    {
+        const int x = sortedSample[i];
+        int j = i;
+        while (j < _sampleSize && sortedSample[j] == x)
+            ++j;
+
+        const int count = j - i;
+        _values.push_back(x);
+        _lowerCounts.push_back(_lowerCounts.back() + count);
+        logSums.push_back((x >= 1) ? count * log((double) x) : 0.0);
+        i = j;
+    }
+
+    // Accumulate from both ends, so that no tail sum is obtained by cancellation.
+    const int distinctSize = (int) _values.size();
+    _lowerLogSums.assign(distinctSize + 1, 0.0);
+    _upperLogSums.assign(distinctSize + 1, 0.0);
+    for (int i = 0; i < distinctSize; ++i)
+        _lowerLogSums[i + 1] = _lowerLogSums[i] + logSums[i];
+    for (int i = distinctSize - 1; i >= 0; --i)
+        _upperLogSums[i] = _upperLogSums[i + 1] + logSums[i];
+}
+
+int TailSummary::LowerBoundIndex(int x) const
+{
+    return static_cast<int>(lower_bound(_values.begin(), _values.end(), x) - _values.begin());
+}
+
+int TailSummary::UpperBoundIndex(int x) const
+{
+    return static_cast<int>(upper_bound(_values.begin(), _values.end(), x) - _values.begin());
+}
+
+int TailSummary::NumberFromIndex(int index) const
+{
+    return _sampleSize - _lowerCounts[index];
+}
+
+double TailSummary::LogSumFromIndex(int index) const
+{
+    return _upperLogSums[index];
+}
+
+int TailSummary::NumberBeforeIndex(int index) const
+{
+    return _lowerCounts[index];
+}
+
+double TailSummary::LogSumBeforeIndex(int index) const
+{
+    return _lowerLogSums[index];
+}
+
+int TailSummary::NumberOfGreaterOrEqual(int x) const
+{
+    return NumberFromIndex(LowerBoundIndex(x));
+}
+
+int TailSummary::NumberOfLowerOrEqual(int x) const
+{
+    return NumberBeforeIndex(UpperBoundIndex(x));
+}
+
+double TailSummary::LogSumOfGreaterOrEqual(int x) const
+{
+    return LogSumFromIndex(LowerBoundIndex(x));
+}
+
+int TailSummary::NumberInRange(int xMin, int xMax) const
+{
+    return max(NumberBeforeIndex(UpperBoundIndex(xMax)) - NumberBeforeIndex(LowerBoundIndex(xMin)), 0);
+}
+
+double TailSummary::LogSumInRange(int xMin, int xMax) const
+{
+    // Ranges that reach one end of the sample are read from the sums accumulated from that end. Other ranges are
+    // subtracted from the sums with the smallest magnitude.
+    const int first = LowerBoundIndex(xMin);
+    const int end = UpperBoundIndex(xMax);
+    if (end <= first)
+        return 0.0;
+    if (first == 0)
+        return _lowerLogSums[end];
+    if (end == GetDistinctSize())
+        return _upperLogSums[first];
+    if (_lowerLogSums[end] <= _upperLogSums[first])
+        return _lowerLogSums[end] - _lowerLogSums[first];
+    return _upperLogSums[first] - _upperLogSums[end];
+}
+
+const vector<int>& TailSummary::GetValues() const
+{
+    return _values;
+}
+
+int TailSummary::GetDistinctSize() const
+{
+    return (int) _values.size();
+}
+
+bool TailSummary::IsEmpty() const
+{
+    return _values.empty();
+}
+
+int TailSummary::Min() const
+{
+    return _values.front();
+}
+
+int TailSummary::Max() const
+{
+    return _values.back();
+}
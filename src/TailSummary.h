@@ -0,0 +1,64 @@
+#pragma once
+#include <vector>
+
+/**
+ * Sorted summary of a sample used for fast tail queries.
+ * Stores the distinct values with their counts and cumulative sums of count * log(x), so the size and the
+ * log-sum of any tail x >= xMin or x <= xMax, or of any range between them, are obtained without rescanning the sample.
+ * Queries by the index of a distinct value take constant time. Queries by value first find that index by binary
+ * search, in O(log d) for d distinct values, which keeps the summary as small as the sample however sparse its tail.
+ */
+class TailSummary
+{
+private:
+    std::vector<int> _values;
+    std::vector<int> _lowerCounts;      // Number of elements lower than _values[i]
+    std::vector<double> _lowerLogSums;  // Sum of log(x) over the elements lower than _values[i]
+    std::vector<double> _upperLogSums;  // Sum of log(x) over the elements greater or equal than _values[i]
+    int _sampleSize;
+
+public:
+    /**
+     * Sorts the sample and accumulates the counts and log-sums of its distinct values.
+     * @param sampleData Sample data.
+     */
+    explicit TailSummary(const std::vector<int>& sampleData);
+
+    /// Index of the first distinct value greater or equal than x.
+    [[nodiscard]] int LowerBoundIndex(int x) const;
+
+    /// Index of the first distinct value greater than x.
+    [[nodiscard]] int UpperBoundIndex(int x) const;
+
+    /// Number of elements greater or equal than the distinct value at the given index.
+    [[nodiscard]] int NumberFromIndex(int index) const;
+
+    /// Sum of log(x) over the elements greater or equal than the distinct value at the given index.
+    [[nodiscard]] double LogSumFromIndex(int index) const;
+
+    /// Number of elements lower than the distinct value at the given index.
+    [[nodiscard]] int NumberBeforeIndex(int index) const;
+
+    /// Sum of log(x) over the elements lower than the distinct value at the given index.
+    [[nodiscard]] double LogSumBeforeIndex(int index) const;
+
+    [[nodiscard]] int NumberOfGreaterOrEqual(int x) const;
+    [[nodiscard]] int NumberOfLowerOrEqual(int x) const;
+    [[nodiscard]] double LogSumOfGreaterOrEqual(int x) const;
+
+    /// Number of elements in the range xMin <= x <= xMax.
+    [[nodiscard]] int NumberInRange(int xMin, int xMax) const;
+
+    /// Sum of log(x) over the elements in the range xMin <= x <= xMax.
+    [[nodiscard]] double LogSumInRange(int xMin, int xMax) const;
+
+    /// Sorted distinct values of the sample.
+    [[nodiscard]] const std::vector<int>& GetValues() const;
+
+    /// Number of distinct values of the sample.
+    [[nodiscard]] int GetDistinctSize() const;
+
+    [[nodiscard]] bool IsEmpty() const;
+    [[nodiscard]] int Min() const;
+    [[nodiscard]] int Max() const;
+};
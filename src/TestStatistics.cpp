@@ -1,12 +1,9 @@
 #include "../include/TestStatistics.h"
-#include "ThreadPool.h"
+#include "SharedThreadPool.h"
 #include "VectorUtilities.h"
 #include "ProgressBar.h"
 using namespace std;
 
-/// Thread pool used in the MultiThread runtime mode.
-static thread_pool pool;
-
 vector<double> measure_bootstrap_ks_statistic(const SyntheticPowerLawGenerator& syntheticGenerator, int replicas, RuntimeMode mode)
 {
     vector<double> tsDistribution;
@@ -27,7 +24,7 @@ vector<double> measure_bootstrap_ks_statistic(const SyntheticPowerLawGenerator&
         vector<future<double>> futures;
         futures.reserve(replicas);
         for (int i = 0; i < replicas; ++i)
-            futures.push_back(pool.submit([&syntheticGenerator]{ return syntheticGenerator.MeasureKsStatisticOfReplica();}));
+            futures.push_back(shared_thread_pool().submit([&syntheticGenerator]{ return syntheticGenerator.MeasureKsStatisticOfReplica();}));
 
         // Get results
         for (future<double>& result : futures)
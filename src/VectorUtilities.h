@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 #include <vector>
 #include <sstream>
 #include <numeric>
@@ -34,6 +35,11 @@ namespace VectorUtilities
         auto removePositions = remove_if(v.begin(), v.end(), [&](auto const& val){ return val >= n; });
         v.erase(removePositions, v.end());
     }
+    template<typename T> void RemoveBetween(std::vector<T>& v, T lower, T upper)
+    {
+        auto removePositions = remove_if(v.begin(), v.end(), [&](auto const& val){ return val >= lower && val <= upper; });
+        v.erase(removePositions, v.end());
+    }
     template<typename T> void Sort(std::vector<T>& v)
     {
         std::sort(v.begin(), v.end());
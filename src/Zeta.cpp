@@ -6,68 +6,17 @@
     Fredrik Johansson.</a>
 */
 
-#include <gsl/gsl_sf.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <complex>
+#include <utility>
 #include "Zeta.h"
+#include "ZetaCoefficients.h"
+#include "ZetaSimd.h"
+#include "ZetaTable.h"
 using namespace std;
 
-/*! Number of entries */
-constexpr int B_2n_fact_size = 51;
-
-/*! Bernoulli numbers divided by factorial, \f$ B_{2n} / (2n)!\f$ */
-constexpr double B_2n_fact[B_2n_fact_size] = {
-        1,
-        0.08333333333333333,
-        -0.001388888888888889,
-        0.00003306878306878307,
-        -8.267195767195768e-7,
-        2.08767569878681e-8,
-        -5.284190138687493e-10,
-        1.3382536530684679e-11,
-        -3.3896802963225827e-13,
-        8.586062056277845e-15,
-        -2.174868698558062e-16,
-        5.50900282836023e-18,
-        -1.3954464685812525e-19,
-        3.534707039629467e-21,
-        -8.953517427037546e-23,
-        2.267952452337683e-24,
-        -5.744790668872202e-26,
-        1.455172475614865e-27,
-        -3.6859949406653103e-29,
-        9.336734257095045e-31,
-        -2.36502241570063e-32,
-        5.990671762482135e-34,
-        -1.51745488446829e-35,
-        3.843758125454189e-37,
-        -9.73635307264669e-39,
-        2.466247044200681e-40,
-        -6.247076741820743e-42,
-        1.5824030244644914e-43,
-        -4.008273685948936e-45,
-        1.0153075855569557e-46,
-        -2.5718041582418717e-48,
-        6.514456035233815e-50,
-        -1.6501309906896525e-51,
-        4.179830628539476e-53,
-        -1.0587634667702908e-54,
-        2.6818791912607708e-56,
-        -6.793279351107421e-58,
-        1.7207577616681404e-59,
-        -4.3587303293488934e-61,
-        1.1040792903684668e-62,
-        -2.7966655133781345e-64,
-        7.084036501679471e-66,
-        -1.794407408289224e-67,
-        4.545287063611096e-69,
-        -1.1513346631982053e-70,
-        2.9163647710923614e-72,
-        -7.387238263497337e-74,
-        1.871209311763795e-75,
-        -4.739828557761799e-77,
-        1.2006125993354507e-78,
-        -3.0411872415142924e-80};
-
 complex<double> S(double s, complex<double> a, int N)
 {
     complex<double> sum = 0.;
@@ -87,26 +36,408 @@ complex<double> T(double s, complex<double> a, int N, int M)
     const complex<double> d = a + static_cast<complex<double>>(N);
     const complex<double> factor = pow(d, -s);
 
-    if (M > B_2n_fact_size)
-        M = B_2n_fact_size;
+    if (M > B_2n_fact_size - 1)
+        M = B_2n_fact_size - 1;
 
+    // The Pochhammer symbols follow (s)_(2k + 1) = (s)_(2k - 1) (s + 2k - 1) (s + 2k).
     complex<double> sum = 0.0;
-
+    double poch = s;
     for (int k = 1; k <= M; k += 1)
-        sum += B_2n_fact[k] * gsl_sf_poch(s, 2. * k - 1.) / pow(d, 2 * k - 1);
+    {
+        sum += B_2n_fact[k] * poch / pow(d, 2 * k - 1);
+        poch *= (s + 2. * k - 1.) * (s + 2. * k);
+    }
 
     return factor * (0.5 + sum);
 }
 
 complex<double> hurwitz_zeta(double s, complex<double> a, int N)
 {
-    if (N > B_2n_fact_size)
-        N = B_2n_fact_size;
+    if (N > B_2n_fact_size - 1)
+        N = B_2n_fact_size - 1;
 
     return S(s, a, N) + I(s, a, N) + T(s, a, N, N);
 }
 
-double real_hurwitz_zeta(double s, double a, int N)
+HurwitzZetaTerms hurwitz_zeta_terms(double s, double a)
 {
-    return hurwitz_zeta(s, a, N).real();
-}
\ No newline at end of file
+    int directTerms = max(0, static_cast<int>(ceil(ZetaTailArgument - a)));
+    while (true)
+    {
+        // For real s the remainder after k - 1 tail terms is smaller than term k,
+        // B_2k / (2k)! (s)_(2k - 1) d^(1 - s - 2k), and zeta(s, a) > d^(1 - s) / (s - 1),
+        // so the relative error is below (s - 1) |B_2k / (2k)!| (s)_(2k - 1) / d^2k.
+        const double d = a + directTerms;
+        const double inverseSquare = 1. / (d * d);
+        double bound = (s - 1.) * s * inverseSquare;
+        for (int k = 1; k <= B_2n_fact_size - 1; k += 1)
+        {
+            if (bound * fabs(B_2n_fact[k]) <= ZetaTolerance)
+                return {directTerms, k - 1};
+            bound *= (s + 2. * k - 1.) * (s + 2. * k) * inverseSquare;
+        }
+
+        // The tail diverges before reaching the tolerance, move the argument further up.
+        directTerms = max(2 * directTerms, 8);
+    }
+}
+
+double S(double s, double a, int N)
+{
+    double sum = 0.;
+    for (int k = 0; k <= N - 1; k += 1)
+        sum += pow(a + k, -s);
+
+    return sum;
+}
+
+double I(double s, double a, int N)
+{
+    return pow(a + N, 1. - s) / (s - 1.);
+}
+
+/// Largest tail term count with a compile-time kernel.
+constexpr int UnrolledTailTerms = 16;
+
+/// Horner evaluation of the tail terms k, ..., K divided by (s)_(2k - 1) d^(1 - 2k). Apart from their coefficients,
+/// consecutive terms differ by the factor (s + 2k - 1) (s + 2k) / d^2, so the Pochhammer symbols nest.
+template <int K, int k = 1>
+[[gnu::always_inline]] inline double bernoulli_horner(double s, double inverseSquare)
+{
+    if constexpr (k == K)
+        return B_2n_fact[K];
+    else
+        return B_2n_fact[k] + (s + 2. * k - 1.) * (s + 2. * k) * inverseSquare *
+                              bernoulli_horner<K, k + 1>(s, inverseSquare);
+}
+
+/// Sum of the first K Bernoulli terms of the tail, B_2k / (2k)! (s)_(2k - 1) / d^(2k - 1), unrolled.
+template <int K>
+double bernoulli_tail(double s, double inverseD)
+{
+    if constexpr (K == 0)
+        return 0.;
+    else
+        return s * inverseD * bernoulli_horner<K>(s, inverseD * inverseD);
+}
+
+template <size_t... K>
+constexpr array<double (*)(double, double), sizeof...(K)> tail_kernels(index_sequence<K...>)
+{
+    return { &bernoulli_tail<(int) K>... };
+}
+
+/// Unrolled tail kernels, indexed by their term count.
+constexpr auto TailKernels = tail_kernels(make_index_sequence<UnrolledTailTerms + 1>());
+
+/// Sum of the first M Bernoulli terms of the tail, with the unrolled kernel of M terms when there is one.
+double bernoulli_tail(double s, double inverseD, int M)
+{
+    if (M <= UnrolledTailTerms)
+        return TailKernels[M](s, inverseD);
+
+    // The Pochhammer symbols follow (s)_(2k + 1) = (s)_(2k - 1) (s + 2k - 1) (s + 2k) and the odd
+    // inverse powers of d follow from repeated division by d^2.
+    double sum = 0.0;
+    double poch = s;
+    double inversePower = inverseD;
+    const double inverseSquare = inverseD * inverseD;
+    for (int k = 1; k <= M; k += 1)
+    {
+        sum += B_2n_fact[k] * poch * inversePower;
+        poch *= (s + 2. * k - 1.) * (s + 2. * k);
+        inversePower *= inverseSquare;
+    }
+    return sum;
+}
+
+double T(double s, double a, int N, int M)
+{
+    const double d = a + N;
+    const double factor = pow(d, -s);
+
+    if (M > B_2n_fact_size - 1)
+        M = B_2n_fact_size - 1;
+
+    return factor * (0.5 + bernoulli_tail(s, 1. / d, M));
+}
+
+/**
+ * Asymptotic expansion of zeta(s, a) for large a, the Euler-Maclaurin sum without direct terms,
+ * a^-s (a / (s - 1) + 1/2 + sum B_2k / (2k)! (s)_(2k - 1) a^(1 - 2k)), with one power for the whole expansion.
+ * The term count comes from the bound of hurwitz_zeta_terms on the relative remainder, so the truncation error is
+ * the same as for the full kernel, and the tail is summed by the unrolled kernel of that count.
+ * @return Whether the expansion reaches the tolerance within the coefficient table.
+ */
+bool asymptotic_hurwitz_zeta(double s, double a, double tolerance, double& value)
+{
+    const double inverseA = 1. / a;
+    const double inverseSquare = inverseA * inverseA;
+    double bound = (s - 1.) * s * inverseSquare;
+    for (int k = 1; k <= B_2n_fact_size - 1; k += 1)
+    {
+        if (bound * fabs(B_2n_fact[k]) <= tolerance)
+        {
+            value = pow(a, -s) * (a / (s - 1.) + 0.5 + bernoulli_tail(s, inverseA, k - 1));
+            return true;
+        }
+        bound *= (s + 2. * k - 1.) * (s + 2. * k) * inverseSquare;
+    }
+
+    return false;
+}
+
+double real_hurwitz_zeta(double s, double a)
+{
+    // Arguments that the direct sum would not move take the expansion at a itself.
+    double value;
+    if (a >= ZetaTailArgument && asymptotic_hurwitz_zeta(s, a, ZetaTolerance, value))
+        return value;
+
+    const HurwitzZetaTerms terms = hurwitz_zeta_terms(s, a);
+    return S(s, a, terms.directTerms) + I(s, a, terms.directTerms) + T(s, a, terms.directTerms, terms.tailTerms);
+}
+
+HurwitzZetaDerivatives real_hurwitz_zeta_derivatives(double s, double a)
+{
+    const HurwitzZetaTerms terms = hurwitz_zeta_terms(s, a);
+    const int N = terms.directTerms;
+
+    // Direct sum, each term (a + k)^-s differentiates to -ln(a + k) (a + k)^-s.
+    HurwitzZetaDerivatives zeta = {0.0, 0.0, 0.0};
+    for (int k = 0; k <= N - 1; k += 1)
+    {
+        const double logTerm = log(a + k);
+        const double term = exp(-s * logTerm);
+        zeta.value += term;
+        zeta.first -= logTerm * term;
+        zeta.second += logTerm * logTerm * term;
+    }
+
+    // Integral term, d^(1 - s) / (s - 1)
+    const double d = a + N;
+    const double logD = log(d);
+    const double inverse = 1. / (s - 1.);
+    const double integral = exp((1. - s) * logD) * inverse;
+    zeta.value += integral;
+    zeta.first -= integral * (logD + inverse);
+    zeta.second += integral * ((logD + inverse) * (logD + inverse) + inverse * inverse);
+
+    // Tail term, d^-s (1/2 + sum B_2k / (2k)! (s)_(2k - 1) / d^(2k - 1)). The Pochhammer symbols
+    // and their derivatives follow from (s)_(2k + 1) = (s)_(2k - 1) (s + 2k - 1) (s + 2k).
+    double poch = s, pochFirst = 1., pochSecond = 0.;
+    double inversePower = 1. / d;
+    const double inverseSquare = inversePower * inversePower;
+    double sum = 0.5, sumFirst = 0., sumSecond = 0.;
+    for (int k = 1; k <= terms.tailTerms; k += 1)
+    {
+        sum += B_2n_fact[k] * poch * inversePower;
+        sumFirst += B_2n_fact[k] * pochFirst * inversePower;
+        sumSecond += B_2n_fact[k] * pochSecond * inversePower;
+
+        const double factor = (s + 2. * k - 1.) * (s + 2. * k);
+        const double factorFirst = 2. * s + 4. * k - 1.;
+        pochSecond = pochSecond * factor + 2. * pochFirst * factorFirst + 2. * poch;
+        pochFirst = pochFirst * factor + poch * factorFirst;
+        poch *= factor;
+        inversePower *= inverseSquare;
+    }
+
+    const double power = exp(-s * logD);
+    zeta.value += power * sum;
+    zeta.first += power * (sumFirst - logD * sum);
+    zeta.second += power * (sumSecond - 2. * logD * sumFirst + logD * logD * sum);
+    return zeta;
+}
+
+/// Vector kernels of the CPU, all null when it supports none of the instruction sets they are built for.
+struct LaneKernels
+{
+    HurwitzZetaLaneKernel zeta;
+    PowerLaneKernel power;
+};
+
+/// Vector kernels for the CPU, selected once from its features.
+const LaneKernels& lane_kernels()
+{
+    static const LaneKernels kernels = []() -> LaneKernels
+    {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        if (!__builtin_cpu_supports("fma"))
+            return { nullptr, nullptr };
+        if (HurwitzZetaAvx512Kernel != nullptr && __builtin_cpu_supports("avx512f"))
+            return { HurwitzZetaAvx512Kernel, PowerAvx512Kernel };
+        if (HurwitzZetaAvx2Kernel != nullptr && __builtin_cpu_supports("avx2"))
+            return { HurwitzZetaAvx2Kernel, PowerAvx2Kernel };
+#endif
+        return { nullptr, nullptr };
+    }();
+
+    return kernels;
+}
+
+/// Vector zeta kernel for the CPU. Null when it supports none of the instruction sets.
+HurwitzZetaLaneKernel hurwitz_zeta_lane_kernel()
+{
+    return lane_kernels().zeta;
+}
+
+/// Evaluates the lanes that the vector kernel left to the scalar one.
+void fill_scalar_lanes(span<const double> s, span<const double> a, span<double> values)
+{
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        if (isnan(values[i]))
+            values[i] = real_hurwitz_zeta(s[i], a[i]);
+    }
+}
+
+void real_hurwitz_zeta_pairs(span<const double> s, span<const double> a, span<double> values)
+{
+    const HurwitzZetaLaneKernel kernel = hurwitz_zeta_lane_kernel();
+    if (kernel == nullptr)
+    {
+        for (size_t i = 0; i < values.size(); ++i)
+            values[i] = real_hurwitz_zeta(s[i], a[i]);
+        return;
+    }
+
+    kernel(s.data(), a.data(), values.data(), values.size());
+    fill_scalar_lanes(s, a, values);
+}
+
+/// Arguments between two anchors of real_hurwitz_zeta_range.
+constexpr int RangeWindowLength = 64;
+
+void inverse_power_range(double s, double a, span<double> values)
+{
+    const PowerLaneKernel powerKernel = lane_kernels().power;
+    array<double, RangeWindowLength> arguments;
+    for (size_t start = 0; start < values.size(); start += arguments.size())
+    {
+        const size_t length = min(arguments.size(), values.size() - start);
+        for (size_t j = 0; j < length; ++j)
+            arguments[j] = a + (double) (start + j);
+
+        double* powers = values.data() + start;
+        if (powerKernel != nullptr)
+            powerKernel(s, arguments.data(), powers, length);
+        for (size_t j = 0; j < length; ++j)
+        {
+            if (powerKernel == nullptr || isnan(powers[j]))
+                powers[j] = pow(arguments[j], -s);
+        }
+    }
+}
+
+void inverse_power_suffix_sums(double s, double a, double sum, span<double> values)
+{
+    inverse_power_range(s, a, values);
+
+    // At small arguments the next power can exceed the running sum (zeta(3.5, 2) < 1), so the rounding error of every
+    // step is recovered with TwoSum, which is exact whichever term is larger.
+    double error = 0.;
+    for (size_t i = values.size(); i-- > 0;)
+    {
+        const double power = values[i];
+        const double next = sum + power;
+        const double rounded = next - sum;
+        error += (sum - (next - rounded)) + (power - rounded);
+        sum = next;
+        values[i] = sum + error;
+    }
+}
+
+void real_hurwitz_zeta_range(double s, double a, span<double> values)
+{
+    const size_t count = values.size();
+    if (count == 0)
+        return;
+
+    // Window w ends at the index (w + 1) W - offset, where the integer part of the argument is a multiple of W.
+    constexpr size_t W = RangeWindowLength;
+    const auto offset = (size_t) fmod(floor(a), (double) W);
+    const size_t windowCount = (count + offset + W - 1) / W;
+
+    // Every anchor is a full evaluation at the upper end of its window, all of them in one call.
+    vector<double> exponents(windowCount, s), anchorArguments(windowCount), anchors(windowCount);
+    for (size_t w = 0; w < windowCount; ++w)
+        anchorArguments[w] = a + (double) ((w + 1) * W - offset);
+    real_hurwitz_zeta_pairs(exponents, anchorArguments, anchors);
+
+    array<double, W> powers;
+    for (size_t w = 0; w < windowCount; ++w)
+    {
+        const size_t end = (w + 1) * W - offset;
+        const size_t start = (end > W) ? end - W : 0;
+        const size_t length = end - start;
+
+        // zeta(s, x) = zeta(s, x + 1) + x^-s downwards from the anchor. The last window may reach past the range.
+        inverse_power_suffix_sums(s, a + (double) start, anchors[w], span(powers).first(length));
+        copy_n(powers.begin(), min(length, count - start), values.begin() + start);
+    }
+}
+
+void real_hurwitz_zeta_batch(const vector<double>& s, double a, vector<double>& values)
+{
+    const size_t count = s.size();
+    values.assign(count, 0.);
+    if (count == 0)
+        return;
+
+    // Batches of grid exponents at a tabulated argument are read from the table in use.
+    if (const ZetaTable* table = shared_zeta_table())
+    {
+        size_t found = 0;
+        while (found < count && table->Find(s[found], a, values[found]))
+            ++found;
+        if (found == count)
+            return;
+        fill(values.begin(), values.end(), 0.);
+    }
+
+    if (hurwitz_zeta_lane_kernel() != nullptr)
+    {
+        // The exponents are the lanes of the vector kernel, with a shared argument.
+        const vector<double> arguments(count, a);
+        real_hurwitz_zeta_pairs(s, arguments, values);
+        return;
+    }
+
+    const HurwitzZetaTerms terms = hurwitz_zeta_terms(*max_element(s.begin(), s.end()), a);
+    const int N = terms.directTerms;
+    const int M = terms.tailTerms;
+
+    // Direct sum, one logarithm per term for the whole batch.
+    for (int k = 0; k <= N - 1; k += 1)
+    {
+        const double logTerm = log(a + k);
+        for (size_t i = 0; i < count; ++i)
+            values[i] += exp(-s[i] * logTerm);
+    }
+
+    // Integral and tail terms. The Pochhammer symbols follow (s)_(2k + 1) = (s)_(2k - 1) (s + 2k - 1) (s + 2k),
+    // and the inverse powers of d are shared.
+    const double d = a + N;
+    const double logD = log(d);
+    vector<double> inversePowers(M + 1);
+    if (M > 0)
+        inversePowers[1] = 1. / d;
+    for (int k = 2; k <= M; k += 1)
+        inversePowers[k] = inversePowers[k - 1] / (d * d);
+
+    vector<double> poch(s), sum(count, 0.5);
+    for (int k = 1; k <= M; k += 1)
+    {
+        const double coefficient = B_2n_fact[k] * inversePowers[k];
+        for (size_t i = 0; i < count; ++i)
+        {
+            sum[i] += coefficient * poch[i];
+            poch[i] *= (s[i] + 2. * k - 1.) * (s[i] + 2. * k);
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i)
+        values[i] += exp((1. - s[i]) * logD) / (s[i] - 1.) + exp(-s[i] * logD) * sum[i];
+}
@@ -36,4 +36,91 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
 
 */
 #pragma once
-double real_hurwitz_zeta(double s, double a, int N = 50);
\ No newline at end of file
+#include <complex>
+#include <span>
+#include <vector>
+
+/// Hurwitz zeta function for a complex argument a, evaluated in complex arithmetic with N direct and tail terms, at
+/// most 50, the size of the Bernoulli table.
+std::complex<double> hurwitz_zeta(double s, std::complex<double> a, int N = 50);
+
+/// Number of direct sum terms and Bernoulli tail terms of an Euler-Maclaurin evaluation.
+struct HurwitzZetaTerms
+{
+    int directTerms;
+    int tailTerms;
+};
+
+/**
+    @brief Smallest term counts that keep the relative Euler-Maclaurin remainder of zeta(s, a) below 1e-15,
+    for real s > 1 and a > 0. The direct sum only moves the argument up to where the
+    tail converges, so large arguments need no direct terms and only a few tail terms.
+*/
+HurwitzZetaTerms hurwitz_zeta_terms(double s, double a);
+
+/**
+    @brief Hurwitz zeta function for real s > 1 and a > 0. Same Euler-Maclaurin sum as
+    hurwitz_zeta, evaluated in real arithmetic with the term counts of hurwitz_zeta_terms. Arguments
+    that need no direct terms take the asymptotic expansion at a, with a single power.
+*/
+double real_hurwitz_zeta(double s, double a);
+
+/// Hurwitz zeta function and its first two derivatives with respect to s.
+struct HurwitzZetaDerivatives
+{
+    double value;
+    double first;
+    double second;
+};
+
+/**
+    @brief Hurwitz zeta function with its first and second derivatives in s,
+    computed in the same Euler-Maclaurin pass as the value, for real s > 1 and a > 0.
+*/
+HurwitzZetaDerivatives real_hurwitz_zeta_derivatives(double s, double a);
+
+/**
+    @brief Hurwitz zeta function of a batch of exponents at the same real argument a > 0.
+    On CPUs with vector instructions the exponents are the lanes of real_hurwitz_zeta_pairs. Otherwise the
+    logarithms and powers of the argument are shared by the whole batch, the exponents are processed
+    together in contiguous lanes, and the term counts are those of the largest exponent, which needs the most.
+    These values differ from real_hurwitz_zeta by less than 4e-15 relative.
+    Batches on the grid of the table in use, see use_zeta_table, are read from it.
+    @param s Exponents, each greater than one.
+    @param values Receives zeta(s[i], a) for every exponent.
+*/
+void real_hurwitz_zeta_batch(const std::vector<double>& s, double a, std::vector<double>& values);
+
+/**
+    @brief Hurwitz zeta function of independent pairs (s[i], a[i]), with s[i] > 1 and a[i] > 0. The pairs are
+    evaluated four or eight at a time with the widest vector instructions of the CPU, selected at run time, or
+    one at a time on CPUs without them.
+    @param values Receives zeta(s[i], a[i]) for every pair, same size as s and a.
+*/
+void real_hurwitz_zeta_pairs(std::span<const double> s, std::span<const double> a, std::span<double> values);
+
+/**
+    @brief Hurwitz zeta function of the consecutive arguments a, a + 1, ..., for real s > 1 and a > 0.
+    Windows of arguments are anchored with full evaluations at their upper ends and filled downwards with
+    zeta(s, x) = zeta(s, x + 1) + x^-s, carrying the rounding error of every step apart. The windows end where the
+    integer part of the argument is a multiple of their length, so for integer a the values do not depend on where
+    the range starts.
+    @param values Receives zeta(s, a + i) for every index i.
+*/
+void real_hurwitz_zeta_range(double s, double a, std::span<double> values);
+
+/**
+    @brief Inverse powers x^-s of the consecutive arguments x = a, a + 1, ..., evaluated with the vector kernel of
+    the CPU where there is one, and with pow otherwise or where the kernel cannot represent the power.
+    @param values Receives (a + i)^-s for every index i.
+*/
+void inverse_power_range(double s, double a, std::span<double> values);
+
+/**
+    @brief Suffix sums of the inverse powers of consecutive arguments, accumulated from the last argument down to the
+    first over the powers of inverse_power_range. The rounding error of every addition is carried apart, so the sums
+    keep full precision over long ranges, whichever of the running sum and the next power is larger.
+    @param sum Value past the last argument, added to every suffix, such as zeta(s, a + n) for n arguments.
+    @param values Receives sum + (a + i)^-s + ... + (a + n - 1)^-s for every index i.
+*/
+void inverse_power_suffix_sums(double s, double a, double sum, std::span<double> values);
@@ -0,0 +1,80 @@
+#include "ZetaSimd.h"
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#include "ZetaSimdKernel.h"
+
+namespace
+{
+
+/// Vector operations of the zeta kernel on four doubles.
+struct Avx2Ops
+{
+    using Vector = __m256d;
+    using Mask = __m256d;
+    static constexpr int Width = 4;
+
+    static Vector Broadcast(double x) { return _mm256_set1_pd(x); }
+    static Vector Load(const double* p) { return _mm256_loadu_pd(p); }
+    static void Store(double* p, Vector x) { _mm256_storeu_pd(p, x); }
+
+    static Vector Add(Vector x, Vector y) { return _mm256_add_pd(x, y); }
+    static Vector Sub(Vector x, Vector y) { return _mm256_sub_pd(x, y); }
+    static Vector Mul(Vector x, Vector y) { return _mm256_mul_pd(x, y); }
+    static Vector Div(Vector x, Vector y) { return _mm256_div_pd(x, y); }
+    static Vector MulAdd(Vector x, Vector y, Vector z) { return _mm256_fmadd_pd(x, y, z); }
+    static Vector Abs(Vector x) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), x); }
+    static Vector Max(Vector x, Vector y) { return _mm256_max_pd(x, y); }
+    static Vector Round(Vector x) { return _mm256_round_pd(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    static Vector Ceil(Vector x) { return _mm256_round_pd(x, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC); }
+
+    static Mask Greater(Vector x, Vector y) { return _mm256_cmp_pd(x, y, _CMP_GT_OQ); }
+    static Mask GreaterEqual(Vector x, Vector y) { return _mm256_cmp_pd(x, y, _CMP_GE_OQ); }
+    static Vector Select(Mask mask, Vector x, Vector y) { return _mm256_blendv_pd(y, x, mask); }
+    static bool Any(Mask mask) { return _mm256_movemask_pd(mask) != 0; }
+
+    /// Biased binary exponent of positive x, as a double.
+    static Vector ExponentField(Vector x)
+    {
+        const __m256i field = _mm256_srli_epi64(_mm256_castpd_si256(x), 52);
+        const __m256d twoTo52 = _mm256_set1_pd(4503599627370496.0);
+        return _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(field, _mm256_castpd_si256(twoTo52))), twoTo52);
+    }
+
+    /// Significand of x scaled to [1, 2).
+    static Vector Mantissa(Vector x)
+    {
+        const __m256i bits = _mm256_and_si256(_mm256_castpd_si256(x), _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL));
+        return _mm256_castsi256_pd(_mm256_or_si256(bits, _mm256_set1_epi64x(0x3FF0000000000000LL)));
+    }
+
+    /// 2^n for integral n in the normal exponent range.
+    static Vector Pow2(Vector n)
+    {
+        const __m256i bits = _mm256_castpd_si256(_mm256_add_pd(n, _mm256_set1_pd(6755399441055744.0)));
+        return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(bits, _mm256_set1_epi64x(1023)), 52));
+    }
+};
+
+void hurwitz_zeta_avx2(const double* s, const double* a, double* values, std::size_t count)
+{
+    hurwitz_zeta_lanes<Avx2Ops>(s, a, values, count);
+    // The compiler does not clear the upper halves of the vector registers on every path, and the scalar code that
+    // runs next would pay for the transition on each instruction.
+    _mm256_zeroupper();
+}
+
+void power_avx2(double s, const double* a, double* values, std::size_t count)
+{
+    power_lanes<Avx2Ops>(s, a, values, count);
+    _mm256_zeroupper();
+}
+
+}
+
+const HurwitzZetaLaneKernel HurwitzZetaAvx2Kernel = &hurwitz_zeta_avx2;
+const PowerLaneKernel PowerAvx2Kernel = &power_avx2;
+#else
+const HurwitzZetaLaneKernel HurwitzZetaAvx2Kernel = nullptr;
+const PowerLaneKernel PowerAvx2Kernel = nullptr;
+#endif
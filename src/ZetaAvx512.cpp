@@ -0,0 +1,80 @@
+#include "ZetaSimd.h"
+
+#if defined(__AVX512F__) && defined(__FMA__)
+#include <immintrin.h>
+#include "ZetaSimdKernel.h"
+
+namespace
+{
+
+/// Vector operations of the zeta kernel on eight doubles.
+struct Avx512Ops
+{
+    using Vector = __m512d;
+    using Mask = __mmask8;
+    static constexpr int Width = 8;
+
+    static Vector Broadcast(double x) { return _mm512_set1_pd(x); }
+    static Vector Load(const double* p) { return _mm512_loadu_pd(p); }
+    static void Store(double* p, Vector x) { _mm512_storeu_pd(p, x); }
+
+    static Vector Add(Vector x, Vector y) { return _mm512_add_pd(x, y); }
+    static Vector Sub(Vector x, Vector y) { return _mm512_sub_pd(x, y); }
+    static Vector Mul(Vector x, Vector y) { return _mm512_mul_pd(x, y); }
+    static Vector Div(Vector x, Vector y) { return _mm512_div_pd(x, y); }
+    static Vector MulAdd(Vector x, Vector y, Vector z) { return _mm512_fmadd_pd(x, y, z); }
+    static Vector Abs(Vector x) { return _mm512_abs_pd(x); }
+    static Vector Max(Vector x, Vector y) { return _mm512_max_pd(x, y); }
+    static Vector Round(Vector x) { return _mm512_roundscale_pd(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+    static Vector Ceil(Vector x) { return _mm512_roundscale_pd(x, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC); }
+
+    static Mask Greater(Vector x, Vector y) { return _mm512_cmp_pd_mask(x, y, _CMP_GT_OQ); }
+    static Mask GreaterEqual(Vector x, Vector y) { return _mm512_cmp_pd_mask(x, y, _CMP_GE_OQ); }
+    static Vector Select(Mask mask, Vector x, Vector y) { return _mm512_mask_blend_pd(mask, y, x); }
+    static bool Any(Mask mask) { return mask != 0; }
+
+    /// Biased binary exponent of positive x, as a double.
+    static Vector ExponentField(Vector x)
+    {
+        const __m512i field = _mm512_srli_epi64(_mm512_castpd_si512(x), 52);
+        const __m512d twoTo52 = _mm512_set1_pd(4503599627370496.0);
+        return _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(field, _mm512_castpd_si512(twoTo52))), twoTo52);
+    }
+
+    /// Significand of x scaled to [1, 2).
+    static Vector Mantissa(Vector x)
+    {
+        const __m512i bits = _mm512_and_si512(_mm512_castpd_si512(x), _mm512_set1_epi64(0x000FFFFFFFFFFFFFLL));
+        return _mm512_castsi512_pd(_mm512_or_si512(bits, _mm512_set1_epi64(0x3FF0000000000000LL)));
+    }
+
+    /// 2^n for integral n in the normal exponent range.
+    static Vector Pow2(Vector n)
+    {
+        const __m512i bits = _mm512_castpd_si512(_mm512_add_pd(n, _mm512_set1_pd(6755399441055744.0)));
+        return _mm512_castsi512_pd(_mm512_slli_epi64(_mm512_add_epi64(bits, _mm512_set1_epi64(1023)), 52));
+    }
+};
+
+void hurwitz_zeta_avx512(const double* s, const double* a, double* values, std::size_t count)
+{
+    hurwitz_zeta_lanes<Avx512Ops>(s, a, values, count);
+    // The compiler does not clear the upper halves of the vector registers on every path, and the scalar code that
+    // runs next would pay for the transition on each instruction.
+    _mm256_zeroupper();
+}
+
+void power_avx512(double s, const double* a, double* values, std::size_t count)
+{
+    power_lanes<Avx512Ops>(s, a, values, count);
+    _mm256_zeroupper();
+}
+
+}
+
+const HurwitzZetaLaneKernel HurwitzZetaAvx512Kernel = &hurwitz_zeta_avx512;
+const PowerLaneKernel PowerAvx512Kernel = &power_avx512;
+#else
+const HurwitzZetaLaneKernel HurwitzZetaAvx512Kernel = nullptr;
+const PowerLaneKernel PowerAvx512Kernel = nullptr;
+#endif
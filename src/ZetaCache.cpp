@@ -0,0 +1,84 @@
+#include "ZetaCache.h"
+#include <bit>
+#include "Zeta.h"
+
+using namespace std;
+
+namespace
+{
+    /// Mixes the bits of both keys so neighbouring grid points spread over shards and slots.
+    uint64_t hash_key(uint64_t s, uint64_t a)
+    {
+        uint64_t h = s ^ (a * 0x9e3779b97f4a7c15ULL);
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+        return h ^ (h >> 31);
+    }
+}
+
+HurwitzZetaCache::HurwitzZetaCache(size_t capacity)
+{
+    _slotMask = bit_ceil(max<size_t>(1, (capacity + ShardCount - 1) / ShardCount)) - 1;
+}
+
+double HurwitzZetaCache::Evaluate(double s, double a)
+{
+    const auto sBits = bit_cast<uint64_t>(s);
+    const auto aBits = bit_cast<uint64_t>(a);
+    const uint64_t hash = hash_key(sBits, aBits);
+    // The top bits of the hash pick the shard and the low bits the slot.
+    Shard& shard = _shards[hash >> (64 - ShardBits)];
+    const size_t slot = hash & _slotMask;
+
+    {
+        lock_guard<mutex> lock(shard.mutex);
+        if (!shard.entries.empty())
+        {
+            const Entry& entry = shard.entries[slot];
+            if (entry.filled && entry.s == sBits && entry.a == aBits)
+            {
+                ++shard.hits;
+                return entry.value;
+            }
+        }
+        ++shard.misses;
+    }
+
+    // Evaluated outside the lock, so other threads keep using the shard meanwhile.
+    const double value = real_hurwitz_zeta(s, a);
+
+    lock_guard<mutex> lock(shard.mutex);
+    if (shard.entries.empty())
+        shard.entries.assign(_slotMask + 1, Entry { 0, 0, 0.0, false });
+    shard.entries[slot] = { sBits, aBits, value, true };
+    return value;
+}
+
+HurwitzZetaCache::Statistics HurwitzZetaCache::GetStatistics() const
+{
+    Statistics statistics { 0, 0 };
+    for (const Shard& shard : _shards)
+    {
+        lock_guard<mutex> lock(shard.mutex);
+        statistics.hits += shard.hits;
+        statistics.misses += shard.misses;
+    }
+    return statistics;
+}
+
+void HurwitzZetaCache::Clear()
+{
+    for (Shard& shard : _shards)
+    {
+        lock_guard<mutex> lock(shard.mutex);
+        shard.entries.clear();
+        shard.hits = 0;
+        shard.misses = 0;
+    }
+}
+
+HurwitzZetaCache& shared_zeta_cache()
+{
+    static HurwitzZetaCache cache;
+    return cache;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * Bounded memoization cache of the real Hurwitz zeta function zeta(s, a), keyed on the exact bit patterns of s and a,
+ * so a hit returns the value the kernel would have computed.
+ * The entries are split over shards, each guarded by its own mutex, so concurrent bootstrap replicas only contend
+ * when their keys land in the same shard. Every shard is a direct-mapped table: a new entry replaces the one that
+ * held its slot, which bounds the memory use. Shard tables are allocated on their first store, so short fits do not
+ * pay for the whole cache.
+ */
+class HurwitzZetaCache
+{
+public:
+    struct Statistics
+    {
+        std::uint64_t hits;
+        std::uint64_t misses;
+    };
+
+    static constexpr int ShardBits = 4;
+    static constexpr int ShardCount = 1 << ShardBits;
+    static constexpr std::size_t DefaultCapacity = 1 << 12;
+
+private:
+    struct Entry
+    {
+        std::uint64_t s;
+        std::uint64_t a;
+        double value;
+        bool filled;
+    };
+
+    struct alignas(64) Shard
+    {
+        mutable std::mutex mutex;
+        std::vector<Entry> entries;     // Allocated on the first store
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+    };
+
+    std::array<Shard, ShardCount> _shards;
+    std::size_t _slotMask;
+
+public:
+    /// @param capacity Total number of entries, rounded up to a power of two per shard.
+    explicit HurwitzZetaCache(std::size_t capacity = DefaultCapacity);
+
+    /// Returns zeta(s, a) from the cache, evaluating and storing it on a miss.
+    double Evaluate(double s, double a);
+
+    /// Number of hits and misses since construction or the last Clear.
+    [[nodiscard]] Statistics GetStatistics() const;
+
+    /// Drops every entry and resets the counters.
+    void Clear();
+};
+
+/// Cache shared by the fitters, the models and the bootstrap replicas.
+HurwitzZetaCache& shared_zeta_cache();
+
+/**
+ * zeta(s, a) through the shared cache. Meant for grid and fitted alphas, which the CDF tables and KS walks of the
+ * candidates and replicas revisit. The trial alphas of the optimizers rarely repeat, and a miss costs more than a
+ * direct evaluation, so they are evaluated directly.
+ */
+inline double cached_hurwitz_zeta(double s, double a)
+{
+    return shared_zeta_cache().Evaluate(s, a);
+}
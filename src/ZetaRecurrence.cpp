@@ -0,0 +1,63 @@
+#include "ZetaRecurrence.h"
+#include "Zeta.h"
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <utility>
+using namespace std;
+
+HurwitzZetaRecurrence::HurwitzZetaRecurrence(vector<double> exponents, int windowLength)
+: _exponents(std::move(exponents))
+{
+    _windowLength = windowLength;
+    _window.resize(_exponents.size() * windowLength);
+    _values.resize(_exponents.size());
+    _windowStart = -1;
+}
+
+int HurwitzZetaRecurrence::WindowOf(int a) const
+{
+    return (a / _windowLength) * _windowLength;
+}
+
+void HurwitzZetaRecurrence::FillWindow(int windowStart)
+{
+    const size_t exponentCount = _exponents.size();
+    const int windowEnd = windowStart + _windowLength;
+
+    // Anchor at the upper end, then accumulate downwards to the start of the window, one exponent row at a time.
+    real_hurwitz_zeta_batch(_exponents, windowEnd, _anchor);
+    const int first = max(windowStart, 1);
+    for (size_t i = 0; i < exponentCount; ++i)
+    {
+        const span<double> row(&_window[i * _windowLength + (first - windowStart)], windowEnd - first);
+        inverse_power_suffix_sums(_exponents[i], first, _anchor[i], row);
+    }
+
+    _windowStart = windowStart;
+}
+
+void HurwitzZetaRecurrence::Seek(int a, int windowReads)
+{
+    if (windowReads < _windowLength / 2)
+    {
+        real_hurwitz_zeta_batch(_exponents, a, _values);
+        return;
+    }
+
+    if (WindowOf(a) != _windowStart)
+        FillWindow(WindowOf(a));
+
+    for (size_t i = 0; i < _exponents.size(); ++i)
+        _values[i] = _window[i * _windowLength + (a - _windowStart)];
+}
+
+const vector<double>& HurwitzZetaRecurrence::GetValues() const
+{
+    return _values;
+}
+
+pair<int, int> HurwitzZetaRecurrence::WindowBounds(int a) const
+{
+    return { WindowOf(a), WindowOf(a) + _windowLength };
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <limits>
+#include <utility>
+#include <vector>
+
+/**
+ * Tracks the Hurwitz zeta function zeta(s, a) of a fixed set of exponents at increasing integer arguments a,
+ * using the recurrence zeta(s, a) = zeta(s, a + 1) + a^-s.
+ * Arguments are grouped in windows of fixed length. Each window is anchored with a full evaluation at its
+ * upper end and filled downwards with compensated sums, so every value keeps the precision of the anchor, and the
+ * value at a given argument does not depend on where the scan started.
+ * Filling a window costs about as much as evaluating half of its arguments in full, so windows from which fewer
+ * arguments are read are not filled, and those arguments are evaluated directly.
+ */
+class HurwitzZetaRecurrence
+{
+private:
+    std::vector<double> _exponents;
+    std::vector<double> _window;    // Values of the current window, one row per exponent
+    std::vector<double> _values;
+    std::vector<double> _anchor;    // Values at the upper end of the window
+    int _windowStart;               // Negative until a window is filled
+    int _windowLength;
+
+    void FillWindow(int windowStart);
+    [[nodiscard]] int WindowOf(int a) const;
+
+public:
+    /**
+     * @param exponents Exponents s for which the function is tracked.
+     * @param windowLength Number of arguments between full evaluations.
+     */
+    explicit HurwitzZetaRecurrence(std::vector<double> exponents, int windowLength = 64);
+
+    /**
+     * Position the recurrence at the argument a >= 1.
+     * @param windowReads Number of arguments that the caller reads from the window of a. Below half the window length
+     * the window is not filled, and a is evaluated directly. Callers must derive it from the argument alone, for
+     * instance from the sample, so that the value at an argument does not depend on the order of the reads.
+     */
+    void Seek(int a, int windowReads = std::numeric_limits<int>::max());
+
+    /// Values of zeta(s, a) for every tracked exponent, at the current argument.
+    [[nodiscard]] const std::vector<double>& GetValues() const;
+
+    /// First argument of the window that holds the argument a, and the first argument past it.
+    [[nodiscard]] std::pair<int, int> WindowBounds(int a) const;
+};
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include "Zeta.h"
+
+/// Target relative error of the real Hurwitz zeta kernels.
+constexpr double ZetaTolerance = 1e-15;
+
+/// Argument d = a + N up to which the direct sum moves the argument.
+constexpr double ZetaTailArgument = 8.;
+
+/**
+ * Vector kernel of the real Hurwitz zeta function over independent (s, a) pairs. Every pair gets the term counts of
+ * hurwitz_zeta_terms. Lanes that need more tail terms than the table holds, or whose powers would leave the range of
+ * the vector exponential, are set to NaN and left to the scalar kernel.
+ */
+using HurwitzZetaLaneKernel = void (*)(const double* s, const double* a, double* values, std::size_t count);
+
+/// AVX2 kernel, four pairs per vector. Null when the build has no AVX2 and FMA support.
+extern const HurwitzZetaLaneKernel HurwitzZetaAvx2Kernel;
+
+/// AVX-512 kernel, eight pairs per vector. Null when the build has no AVX-512 support.
+extern const HurwitzZetaLaneKernel HurwitzZetaAvx512Kernel;
+
+/// Vector kernel of the powers a[i]^-s. Lanes whose power would leave the range of the vector exponential are NaN.
+using PowerLaneKernel = void (*)(double s, const double* a, double* values, std::size_t count);
+
+/// AVX2 power kernel. Null when the build has no AVX2 and FMA support.
+extern const PowerLaneKernel PowerAvx2Kernel;
+
+/// AVX-512 power kernel. Null when the build has no AVX-512 support.
+extern const PowerLaneKernel PowerAvx512Kernel;
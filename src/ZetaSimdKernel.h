@@ -0,0 +1,285 @@
+#pragma once
+#include <cstddef>
+#include "ZetaCoefficients.h"
+#include "ZetaSimd.h"
+
+/*
+ * Vector Hurwitz zeta and power kernels, shared by the instruction set translation units. Each of them includes this header
+ * once, compiled with its own target flags, and instantiates the kernels with its vector operations. Everything here
+ * has internal linkage and uses no inline library templates, so no code built for a wider instruction set can be
+ * merged into the rest of the program by the linker.
+ *
+ * The operations type provides the vector width, the arithmetic, lane masks and the bit manipulations of the
+ * logarithm and the exponential.
+ */
+namespace
+{
+
+constexpr double Sqrt2 = 1.41421356237309504880;
+constexpr double Log2E = 1.44269504088896338700;
+
+// Two part ln 2, the high part has enough trailing zeros for its products with exponents to be exact.
+constexpr double Ln2High = 6.93147180369123816490e-01;
+constexpr double Ln2Low = 1.90821492927058770002e-10;
+
+// Minimax coefficients of log(1 + f) on [sqrt(2)/2 - 1, sqrt(2) - 1], as in fdlibm.
+constexpr double Lg1 = 6.666666666666735130e-01;
+constexpr double Lg2 = 3.999999999940941908e-01;
+constexpr double Lg3 = 2.857142874366239149e-01;
+constexpr double Lg4 = 2.222219843214978396e-01;
+constexpr double Lg5 = 1.818357216161805012e-01;
+constexpr double Lg6 = 1.531383769920937332e-01;
+constexpr double Lg7 = 1.479819860511658591e-01;
+
+/// Largest magnitude of the exponent of a power that the vector exponential evaluates.
+constexpr double MaxExponent = 700.0;
+
+/// Logarithm split in a part exactly representable from the binary exponent and a small remainder.
+template <class Ops>
+struct SplitLog
+{
+    typename Ops::Vector high;
+    typename Ops::Vector low;
+};
+
+/// Logarithm of positive normal numbers, with the error of the fdlibm reduction and the binary exponent kept exact.
+template <class Ops>
+[[gnu::always_inline]] inline SplitLog<Ops> split_log(typename Ops::Vector x)
+{
+    using Vector = typename Ops::Vector;
+
+    // x = 2^e m with m in [sqrt(2)/2, sqrt(2)).
+    Vector exponent = Ops::Sub(Ops::ExponentField(x), Ops::Broadcast(1023.));
+    Vector mantissa = Ops::Mantissa(x);
+    const auto large = Ops::Greater(mantissa, Ops::Broadcast(Sqrt2));
+    mantissa = Ops::Select(large, Ops::Mul(mantissa, Ops::Broadcast(0.5)), mantissa);
+    exponent = Ops::Select(large, Ops::Add(exponent, Ops::Broadcast(1.)), exponent);
+
+    // log(1 + f) = f - f^2 / 2 + t (f^2 / 2 + R(t^2)) with t = f / (2 + f).
+    const Vector f = Ops::Sub(mantissa, Ops::Broadcast(1.));
+    const Vector halfSquare = Ops::Mul(Ops::Broadcast(0.5), Ops::Mul(f, f));
+    const Vector t = Ops::Div(f, Ops::Add(Ops::Broadcast(2.), f));
+    const Vector z = Ops::Mul(t, t);
+    const Vector w = Ops::Mul(z, z);
+    const Vector evenTerms = Ops::Mul(w, Ops::MulAdd(w, Ops::MulAdd(w, Ops::Broadcast(Lg6), Ops::Broadcast(Lg4)),
+                                                     Ops::Broadcast(Lg2)));
+    const Vector oddTerms = Ops::Mul(z, Ops::MulAdd(w, Ops::MulAdd(w, Ops::MulAdd(w, Ops::Broadcast(Lg7),
+                                                                                  Ops::Broadcast(Lg5)),
+                                                                   Ops::Broadcast(Lg3)),
+                                                    Ops::Broadcast(Lg1)));
+    const Vector r = Ops::Add(evenTerms, oddTerms);
+    const Vector logMantissa = Ops::Sub(f, Ops::Sub(halfSquare, Ops::Mul(t, Ops::Add(halfSquare, r))));
+
+    return { Ops::Mul(exponent, Ops::Broadcast(Ln2High)),
+             Ops::MulAdd(exponent, Ops::Broadcast(Ln2Low), logMantissa) };
+}
+
+/// exp(high + low) for |high| <= MaxExponent and |low| much smaller than the spacing of high.
+template <class Ops>
+[[gnu::always_inline]] inline typename Ops::Vector split_exp(typename Ops::Vector high, typename Ops::Vector low)
+{
+    using Vector = typename Ops::Vector;
+
+    // high + low = n ln 2 + r with |r| <= ln 2 / 2.
+    const Vector n = Ops::Round(Ops::Mul(high, Ops::Broadcast(Log2E)));
+    const Vector negativeN = Ops::Sub(Ops::Broadcast(0.), n);
+    Vector r = Ops::MulAdd(negativeN, Ops::Broadcast(Ln2High), high);
+    r = Ops::Add(Ops::MulAdd(negativeN, Ops::Broadcast(Ln2Low), r), low);
+
+    // Taylor polynomial of degree 13, truncation below 5e-18 on the reduced interval.
+    Vector polynomial = Ops::Broadcast(1. / 6227020800.);
+    constexpr double InverseFactorials[] = { 1. / 479001600., 1. / 39916800., 1. / 3628800., 1. / 362880.,
+                                             1. / 40320., 1. / 5040., 1. / 720., 1. / 120., 1. / 24., 1. / 6.,
+                                             1. / 2., 1., 1. };
+    for (double coefficient : InverseFactorials)
+        polynomial = Ops::MulAdd(polynomial, r, Ops::Broadcast(coefficient));
+
+    return Ops::Mul(polynomial, Ops::Pow2(n));
+}
+
+/// x^t from the split logarithm of x. The product t log(x) is carried in two parts, so the power keeps the
+/// accuracy of the logarithm instead of losing the magnitude of t log(x) in units in the last place.
+template <class Ops>
+[[gnu::always_inline]] inline typename Ops::Vector split_pow(const SplitLog<Ops>& logX, typename Ops::Vector t)
+{
+    using Vector = typename Ops::Vector;
+
+    const Vector product = Ops::Mul(t, logX.high);
+    const Vector productError = Ops::MulAdd(t, logX.high, Ops::Sub(Ops::Broadcast(0.), product));
+    const Vector remainder = Ops::MulAdd(t, logX.low, productError);
+    const Vector high = Ops::Add(product, remainder);
+    const Vector low = Ops::Sub(remainder, Ops::Sub(high, product));
+    return split_exp<Ops>(high, low);
+}
+
+/// Whether |t log(x)| stays within the range of split_exp in every lane.
+template <class Ops>
+[[gnu::always_inline]] inline bool in_exp_range(const SplitLog<Ops>& logX, typename Ops::Vector t)
+{
+    const auto exponent = Ops::Abs(Ops::Mul(t, Ops::Add(logX.high, logX.low)));
+    return !Ops::Any(Ops::Greater(exponent, Ops::Broadcast(MaxExponent)));
+}
+
+/// Term counts of hurwitz_zeta_terms for every lane, with the same arithmetic. Lanes whose tail needs more terms than
+/// the table holds get a negative tail count.
+template <class Ops>
+void plan_terms(typename Ops::Vector s, typename Ops::Vector a, typename Ops::Vector& directTerms,
+                typename Ops::Vector& tailTerms)
+{
+    using Vector = typename Ops::Vector;
+
+    directTerms = Ops::Max(Ops::Ceil(Ops::Sub(Ops::Broadcast(ZetaTailArgument), a)), Ops::Broadcast(0.));
+    const Vector d = Ops::Add(a, directTerms);
+    const Vector inverseSquare = Ops::Div(Ops::Broadcast(1.), Ops::Mul(d, d));
+    Vector bound = Ops::Mul(Ops::Mul(Ops::Sub(s, Ops::Broadcast(1.)), s), inverseSquare);
+    tailTerms = Ops::Broadcast(-1.);
+    for (int k = 1; k <= B_2n_fact_size - 1; ++k)
+    {
+        const double coefficient = (B_2n_fact[k] < 0.) ? -B_2n_fact[k] : B_2n_fact[k];
+        const auto converged = Ops::GreaterEqual(Ops::Broadcast(ZetaTolerance),
+                                                 Ops::Mul(bound, Ops::Broadcast(coefficient)));
+        const auto open = Ops::Greater(Ops::Broadcast(0.), tailTerms);
+        tailTerms = Ops::Select(open, Ops::Select(converged, Ops::Broadcast(k - 1.), tailTerms), tailTerms);
+        if (!Ops::Any(Ops::Greater(Ops::Broadcast(0.), tailTerms)))
+            return;
+
+        const Vector factor = Ops::Mul(Ops::Add(s, Ops::Broadcast(2. * k - 1.)), Ops::Add(s, Ops::Broadcast(2. * k)));
+        bound = Ops::Mul(bound, Ops::Mul(factor, inverseSquare));
+    }
+}
+
+/// Largest lane of a vector.
+template <class Ops>
+int max_lane(typename Ops::Vector x)
+{
+    alignas(64) double lanes[Ops::Width];
+    Ops::Store(lanes, x);
+    double largest = lanes[0];
+    for (int i = 1; i < Ops::Width; ++i)
+        largest = (lanes[i] > largest) ? lanes[i] : largest;
+    return (int) largest;
+}
+
+/// Euler-Maclaurin evaluation of Ops::Width pairs, with the same terms as the scalar kernel of Zeta.cpp.
+template <class Ops>
+void hurwitz_zeta_vector(const double* s, const double* a, double* values)
+{
+    using Vector = typename Ops::Vector;
+
+    const Vector sVector = Ops::Load(s);
+    const Vector aVector = Ops::Load(a);
+    Vector directVector, tailVector;
+    plan_terms<Ops>(sVector, aVector, directVector, tailVector);
+    const Vector negativeS = Ops::Sub(Ops::Broadcast(0.), sVector);
+    const Vector d = Ops::Add(aVector, directVector);
+
+    // |s log(x)| is largest at one of the ends of [a, d] for positive x.
+    const SplitLog<Ops> logA = split_log<Ops>(aVector);
+    const SplitLog<Ops> logD = split_log<Ops>(d);
+    if (Ops::Any(Ops::Greater(Ops::Broadcast(0.), tailVector)) ||
+        !in_exp_range<Ops>(logA, sVector) || !in_exp_range<Ops>(logD, sVector))
+    {
+        for (int i = 0; i < Ops::Width; ++i)
+            values[i] = __builtin_nan("");
+        return;
+    }
+
+    // Direct sum, lanes with fewer terms add zeros.
+    const int directTerms = max_lane<Ops>(directVector);
+    Vector sum = Ops::Broadcast(0.);
+    for (int k = 0; k < directTerms; ++k)
+    {
+        const Vector kVector = Ops::Broadcast((double) k);
+        const Vector term = split_pow<Ops>((k == 0) ? logA : split_log<Ops>(Ops::Add(aVector, kVector)), negativeS);
+        sum = Ops::Add(sum, Ops::Select(Ops::Greater(directVector, kVector), term, Ops::Broadcast(0.)));
+    }
+
+    // Tail sum 1/2 + sum B_2k / (2k)! (s)_(2k - 1) / d^(2k - 1).
+    const int tailTerms = max_lane<Ops>(tailVector);
+    Vector poch = sVector;
+    Vector inversePower = Ops::Div(Ops::Broadcast(1.), d);
+    const Vector inverseSquare = Ops::Mul(inversePower, inversePower);
+    Vector tailSum = Ops::Broadcast(0.5);
+    for (int k = 1; k <= tailTerms; ++k)
+    {
+        const Vector term = Ops::Mul(Ops::Mul(Ops::Broadcast(B_2n_fact[k]), poch), inversePower);
+        tailSum = Ops::Add(tailSum, Ops::Select(Ops::Greater(tailVector, Ops::Broadcast(k - 1.)), term,
+                                                Ops::Broadcast(0.)));
+        poch = Ops::Mul(poch, Ops::Mul(Ops::Add(sVector, Ops::Broadcast(2. * k - 1.)),
+                                       Ops::Add(sVector, Ops::Broadcast(2. * k))));
+        inversePower = Ops::Mul(inversePower, inverseSquare);
+    }
+
+    // Integral and tail terms share d^-s, d^(1 - s) / (s - 1) + d^-s tailSum.
+    const Vector integralFactor = Ops::Div(d, Ops::Sub(sVector, Ops::Broadcast(1.)));
+    sum = Ops::MulAdd(split_pow<Ops>(logD, negativeS), Ops::Add(integralFactor, tailSum), sum);
+
+    Ops::Store(values, sum);
+}
+
+/// Runs the vector kernel over all pairs. The last vector is padded with copies of its first pair, which cost no
+/// more terms than the pairs it holds.
+template <class Ops>
+void hurwitz_zeta_lanes(const double* s, const double* a, double* values, std::size_t count)
+{
+    constexpr int Width = Ops::Width;
+
+    std::size_t first = 0;
+    for (; first + Width <= count; first += Width)
+        hurwitz_zeta_vector<Ops>(s + first, a + first, values + first);
+
+    if (first < count)
+    {
+        alignas(64) double sLanes[Width], aLanes[Width], valueLanes[Width];
+        for (int i = 0; i < Width; ++i)
+        {
+            const std::size_t pair = (first + i < count) ? first + i : first;
+            sLanes[i] = s[pair];
+            aLanes[i] = a[pair];
+        }
+
+        hurwitz_zeta_vector<Ops>(sLanes, aLanes, valueLanes);
+        for (std::size_t i = 0; first + i < count; ++i)
+            values[first + i] = valueLanes[i];
+    }
+}
+
+/// Powers a^-s of Ops::Width positive arguments, NaN in every lane when one of them leaves the range of split_exp.
+template <class Ops>
+void power_vector(const double* a, typename Ops::Vector negativeS, double* values)
+{
+    const SplitLog<Ops> logA = split_log<Ops>(Ops::Load(a));
+    if (!in_exp_range<Ops>(logA, negativeS))
+    {
+        for (int i = 0; i < Ops::Width; ++i)
+            values[i] = __builtin_nan("");
+        return;
+    }
+
+    Ops::Store(values, split_pow<Ops>(logA, negativeS));
+}
+
+/// Runs the power kernel over all arguments, padding the last vector with copies of its first argument.
+template <class Ops>
+void power_lanes(double s, const double* a, double* values, std::size_t count)
+{
+    constexpr int Width = Ops::Width;
+    const typename Ops::Vector negativeS = Ops::Broadcast(-s);
+
+    std::size_t first = 0;
+    for (; first + Width <= count; first += Width)
+        power_vector<Ops>(a + first, negativeS, values + first);
+
+    if (first < count)
+    {
+        alignas(64) double aLanes[Width], valueLanes[Width];
+        for (int i = 0; i < Width; ++i)
+            aLanes[i] = a[(first + i < count) ? first + i : first];
+
+        power_vector<Ops>(aLanes, negativeS, valueLanes);
+        for (std::size_t i = 0; first + i < count; ++i)
+            values[first + i] = valueLanes[i];
+    }
+}
+
+}
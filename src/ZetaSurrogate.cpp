@@ -0,0 +1,146 @@
+#include "ZetaSurrogate.h"
+#include <bit>
+#include <limits>
+#include <memory>
+#include <numbers>
+#include <span>
+#include "Zeta.h"
+
+using namespace std;
+
+namespace
+{
+    using Nodes = array<double, LogZetaSurrogate::NodeCount>;
+
+    /// Chebyshev nodes of the first kind, cos(pi (k + 1/2) / n), on [-1, 1].
+    const Nodes& chebyshev_nodes()
+    {
+        static const Nodes nodes = []
+        {
+            Nodes x {};
+            for (int k = 0; k < LogZetaSurrogate::NodeCount; ++k)
+                x[k] = cos(numbers::pi * (k + 0.5) / LogZetaSurrogate::NodeCount);
+            return x;
+        }();
+        return nodes;
+    }
+
+    /// cos(pi j (k + 1/2) / n) for every coefficient j and node k, the discrete cosine transform of the fit.
+    const array<Nodes, LogZetaSurrogate::NodeCount>& chebyshev_cosines()
+    {
+        static const array<Nodes, LogZetaSurrogate::NodeCount> cosines = []
+        {
+            array<Nodes, LogZetaSurrogate::NodeCount> c {};
+            for (int j = 0; j < LogZetaSurrogate::NodeCount; ++j)
+                for (int k = 0; k < LogZetaSurrogate::NodeCount; ++k)
+                    c[j][k] = cos(numbers::pi * j * (k + 0.5) / LogZetaSurrogate::NodeCount);
+            return c;
+        }();
+        return cosines;
+    }
+
+    unique_ptr<LogZetaSurrogateStore> sharedSurrogates;
+}
+
+LogZetaSurrogate::LogZetaSurrogate(int a)
+{
+    constexpr int n = NodeCount;
+    const Nodes& nodes = chebyshev_nodes();
+
+    Nodes exponents {}, arguments {}, remainders {};
+    for (int k = 0; k < n; ++k)
+        exponents[k] = 0.5 * (LowerExponent + UpperExponent) + 0.5 * (UpperExponent - LowerExponent) * nodes[k];
+    arguments.fill(a);
+    real_hurwitz_zeta_pairs(exponents, arguments, remainders);
+
+    _logArgument = log(a);
+    for (int k = 0; k < n; ++k)
+        remainders[k] = log(remainders[k]) + log(exponents[k] - 1.0) + (exponents[k] - 1.0) * _logArgument;
+
+    const auto& cosines = chebyshev_cosines();
+    for (int j = 0; j < n; ++j)
+    {
+        double sum = 0.0;
+        for (int k = 0; k < n; ++k)
+            sum += remainders[k] * cosines[j][k];
+        _coefficients[j] = 2.0 * sum / n;
+    }
+    _coefficients[0] *= 0.5;
+
+    // The exact values are accurate to a few units of the last place of ln zeta, which is about (s - 1) ln a in
+    // magnitude for large arguments.
+    const double magnitude = 1.0 + (UpperExponent - 1.0) * _logArgument;
+    _errorBound = 2.0 * (fabs(_coefficients[n - 1]) + fabs(_coefficients[n - 2])) +
+                  8.0 * numeric_limits<double>::epsilon() * magnitude;
+    if (isnan(_errorBound))
+        _errorBound = numeric_limits<double>::infinity();
+}
+
+double LogZetaSurrogate::GetErrorBound() const
+{
+    return _errorBound;
+}
+
+bool LogZetaSurrogate::IsAccurate() const
+{
+    return _errorBound <= Tolerance;
+}
+
+LogZetaSurrogateStore::LogZetaSurrogateStore(size_t capacity)
+{
+    _slotMask = bit_ceil(max<size_t>(1, (capacity + ShardCount - 1) / ShardCount)) - 1;
+}
+
+bool LogZetaSurrogateStore::Find(int xMin, LogZetaSurrogate& surrogate)
+{
+    // Consecutive candidates go to consecutive shards, and wrap around the slots of a shard.
+    Shard& shard = _shards[(unsigned) xMin % ShardCount];
+    const size_t slot = ((unsigned) xMin / ShardCount) & _slotMask;
+
+    {
+        lock_guard<mutex> lock(shard.mutex);
+        if (!shard.entries.empty() && shard.entries[slot].xMin == xMin)
+        {
+            surrogate = shard.entries[slot].surrogate;
+            return surrogate.IsAccurate();
+        }
+    }
+
+    // Built outside the lock, so other threads keep using the shard meanwhile.
+    surrogate = LogZetaSurrogate(xMin);
+
+    lock_guard<mutex> lock(shard.mutex);
+    if (shard.entries.empty())
+        shard.entries.assign(_slotMask + 1, Entry { 0, LogZetaSurrogate() });
+    shard.entries[slot] = { xMin, surrogate };
+    ++shard.statistics.built;
+    if (!surrogate.IsAccurate())
+        ++shard.statistics.rejected;
+    else
+        shard.statistics.largestErrorBound = max(shard.statistics.largestErrorBound, surrogate.GetErrorBound());
+    return surrogate.IsAccurate();
+}
+
+LogZetaSurrogateStore::Statistics LogZetaSurrogateStore::GetStatistics() const
+{
+    Statistics statistics { 0, 0, 0.0 };
+    for (const Shard& shard : _shards)
+    {
+        lock_guard<mutex> lock(shard.mutex);
+        statistics.built += shard.statistics.built;
+        statistics.rejected += shard.statistics.rejected;
+        statistics.largestErrorBound = max(statistics.largestErrorBound, shard.statistics.largestErrorBound);
+    }
+    return statistics;
+}
+
+void use_zeta_surrogates()
+{
+    if (!sharedSurrogates)
+        sharedSurrogates = make_unique<LogZetaSurrogateStore>();
+}
+
+LogZetaSurrogateStore* shared_zeta_surrogates()
+{
+    return sharedSurrogates.get();
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * Chebyshev approximation of ln zeta(s, a) in the exponent, for a fixed integer argument, over the interval in which
+ * alpha is searched. The pole at s = 1 and the a^(1-s) decay are factored out,
+ * ln zeta(s, a) = g(s) - ln(s - 1) - (s - 1) ln a, which leaves a remainder g that is analytic far around the interval,
+ * so a few exact evaluations at the Chebyshev nodes fit it to rounding error.
+ */
+class LogZetaSurrogate
+{
+public:
+    static constexpr double LowerExponent = 1.50;
+    static constexpr double UpperExponent = 3.51;
+    static constexpr int NodeCount = 16;
+
+    /// Largest accepted error bound of ln zeta(s, a), which is also the relative error of zeta(s, a).
+    static constexpr double Tolerance = 1e-12;
+
+private:
+    double _logArgument = 0.0;
+    double _errorBound = 0.0;
+    std::array<double, NodeCount> _coefficients {};
+
+public:
+    LogZetaSurrogate() = default;
+
+    /// Fits the approximation to exact evaluations of zeta(s, a) at the Chebyshev nodes of the interval.
+    explicit LogZetaSurrogate(int a);
+
+    /// Approximation of ln zeta(s, a), for s from LowerExponent to UpperExponent.
+    [[nodiscard]] double Evaluate(double s) const
+    {
+        // Clenshaw recurrence on the exponent mapped to [-1, 1].
+        const double x = (2.0 * s - (LowerExponent + UpperExponent)) / (UpperExponent - LowerExponent);
+        double b1 = 0.0, b2 = 0.0;
+        for (int j = NodeCount - 1; j > 0; --j)
+        {
+            const double b = 2.0 * x * b1 - b2 + _coefficients[j];
+            b2 = b1;
+            b1 = b;
+        }
+        return x * b1 - b2 + _coefficients[0] - std::log(s - 1.0) - (s - 1.0) * _logArgument;
+    }
+
+    /**
+     * Estimated bound of the absolute error of Evaluate over the interval, from the trailing Chebyshev coefficients,
+     * which bound the truncation error of a series that converges this fast, and from the rounding of the exact values.
+     */
+    [[nodiscard]] double GetErrorBound() const;
+
+    /// Whether the error bound is within Tolerance.
+    [[nodiscard]] bool IsAccurate() const;
+};
+
+/**
+ * Surrogates of ln zeta(alpha, xMin), one per xMin, shared by the fits and the bootstrap replicas, which scan the same
+ * candidates over and over. The store is split in shards of direct-mapped slots like HurwitzZetaCache, so its memory
+ * use is bounded and concurrent replicas rarely contend.
+ */
+class LogZetaSurrogateStore
+{
+public:
+    struct Statistics
+    {
+        std::uint64_t built;
+        std::uint64_t rejected;     // Built, but with an error bound above the tolerance
+        double largestErrorBound;   // Largest error bound of the accepted surrogates
+    };
+
+    static constexpr int ShardBits = 4;
+    static constexpr int ShardCount = 1 << ShardBits;
+    static constexpr std::size_t DefaultCapacity = 1 << 10;
+
+private:
+    struct Entry
+    {
+        int xMin;                   // Zero while the slot is empty
+        LogZetaSurrogate surrogate;
+    };
+
+    struct alignas(64) Shard
+    {
+        mutable std::mutex mutex;
+        std::vector<Entry> entries; // Allocated on the first store
+        Statistics statistics { 0, 0, 0.0 };
+    };
+
+    std::array<Shard, ShardCount> _shards;
+    std::size_t _slotMask;
+
+public:
+    /// @param capacity Total number of surrogates, rounded up to a power of two per shard.
+    explicit LogZetaSurrogateStore(std::size_t capacity = DefaultCapacity);
+
+    /**
+     * Copies the surrogate of an xMin from the store, building and storing it when it is missing.
+     * @return Whether the surrogate is within the tolerance. The exact normalizer must be used otherwise.
+     */
+    bool Find(int xMin, LogZetaSurrogate& surrogate);
+
+    /// Number of surrogates built and rejected, and the largest error bound of those accepted.
+    [[nodiscard]] Statistics GetStatistics() const;
+};
+
+/**
+ * Makes the left bounded alpha estimators maximize the log-likelihood through the surrogates of ln zeta(alpha, xMin),
+ * instead of exact evaluations of the normalizing constant. Must be called before fitting starts.
+ */
+void use_zeta_surrogates();
+
+/// Surrogates of the process, or null when they are not in use.
+LogZetaSurrogateStore* shared_zeta_surrogates();
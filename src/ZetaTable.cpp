@@ -0,0 +1,226 @@
+#include "ZetaTable.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <span>
+#include "Zeta.h"
+
+#if defined(_WIN32)
+#include <process.h>
+#define getpid _getpid
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace
+{
+    /// Layout of the table file, followed by the values.
+    struct TableHeader
+    {
+        char magic[8];
+        uint32_t version;
+        int32_t gridDivisor;
+        int32_t lowerIntExponent;
+        int32_t exponentCount;
+        int32_t maxArgument;
+        int32_t reserved;
+        double byteOrderCheck;      // Tells apart files written on a machine of different byte order
+    };
+
+    constexpr char TableMagic[8] = "PLZETA";
+    constexpr uint32_t TableVersion = 2;
+    constexpr double ByteOrderCheck = 1.0 / 3.0;
+
+    TableHeader table_header(int maxArgument)
+    {
+        TableHeader header {};
+        memcpy(header.magic, TableMagic, sizeof header.magic);
+        header.version = TableVersion;
+        header.gridDivisor = ZetaTable::GridDivisor;
+        header.lowerIntExponent = ZetaTable::LowerIntExponent;
+        header.exponentCount = ZetaTable::ExponentCount;
+        header.maxArgument = maxArgument;
+        header.byteOrderCheck = ByteOrderCheck;
+        return header;
+    }
+
+    /// Exponent of a table column, rounded as DiscretePowerLawDistribution::AlphaGrid rounds it.
+    double column_exponent(int column)
+    {
+        return (double) (ZetaTable::LowerIntExponent + column) / ZetaTable::GridDivisor;
+    }
+
+    /// Values of a mapped file, or null when it is not a table of this layout.
+    const double* table_values(const void* data, size_t size, int& maxArgument)
+    {
+        if (size < sizeof(TableHeader))
+            return nullptr;
+
+        TableHeader header {};
+        memcpy(&header, data, sizeof header);
+        const TableHeader expected = table_header(header.maxArgument);
+        if (memcmp(header.magic, expected.magic, sizeof header.magic) != 0 || header.version != expected.version ||
+            header.gridDivisor != expected.gridDivisor || header.lowerIntExponent != expected.lowerIntExponent ||
+            header.exponentCount != expected.exponentCount || header.byteOrderCheck != expected.byteOrderCheck ||
+            header.maxArgument < 1)
+            return nullptr;
+
+        const size_t valueCount = (size_t) header.exponentCount * header.maxArgument;
+        if (size != sizeof(TableHeader) + 2 * valueCount * sizeof(double))
+            return nullptr;
+
+        maxArgument = header.maxArgument;
+        return reinterpret_cast<const double*>(static_cast<const char*>(data) + sizeof(TableHeader));
+    }
+
+    unique_ptr<ZetaTable> sharedTable;
+}
+
+bool ZetaTable::Generate(const string& path, int maxArgument)
+{
+    if (maxArgument < 1)
+        return false;
+
+    // One row of exponents per argument, evaluated as pairs by the vector kernel.
+    vector<double> values((size_t) ExponentCount * maxArgument);
+    vector<double> exponents(ExponentCount), arguments(ExponentCount);
+    for (int column = 0; column < ExponentCount; ++column)
+        exponents[column] = column_exponent(column);
+    for (int x = 1; x <= maxArgument; ++x)
+    {
+        arguments.assign(ExponentCount, x);
+        real_hurwitz_zeta_pairs(exponents, arguments, span(values).subspan((size_t) (x - 1) * ExponentCount,
+                                                                           ExponentCount));
+    }
+
+    // The table again with one row of arguments per exponent, for reads along the arguments, evaluated as
+    // ranges of consecutive arguments like the left bounded CDF evaluates them.
+    const size_t valueCount = values.size();
+    values.resize(2 * valueCount);
+    for (int column = 0; column < ExponentCount; ++column)
+        real_hurwitz_zeta_range(exponents[column], 1, span(values).subspan(valueCount + (size_t) column * maxArgument,
+                                                                            maxArgument));
+
+    const TableHeader header = table_header(maxArgument);
+    const string temporaryPath = path + ".tmp" + to_string(getpid());
+    {
+        ofstream file(temporaryPath, ios::binary | ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof header);
+        file.write(reinterpret_cast<const char*>(values.data()), (streamsize) (values.size() * sizeof(double)));
+        if (!file)
+        {
+            file.close();
+            remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+
+    if (rename(temporaryPath.c_str(), path.c_str()) != 0)
+    {
+        remove(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+ZetaTable::ZetaTable(const string& path)
+{
+    for (int column = 0; column < ExponentCount; ++column)
+        _exponents[column] = column_exponent(column);
+
+#if defined(_WIN32)
+    ifstream file(path, ios::binary | ios::ate);
+    if (!file)
+        return;
+    const auto size = (size_t) file.tellg();
+    _buffer.resize((size + sizeof(double) - 1) / sizeof(double));
+    file.seekg(0);
+    if (file.read(reinterpret_cast<char*>(_buffer.data()), (streamsize) size))
+        _values = table_values(_buffer.data(), size, _maxArgument);
+#else
+    const int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        return;
+
+    struct stat status {};
+    if (fstat(descriptor, &status) == 0 && status.st_size > 0)
+    {
+#if defined(MAP_POPULATE)
+        // Maps every page up front, the file is small and already in the page cache of a shared run.
+        const int flags = MAP_SHARED | MAP_POPULATE;
+#else
+        const int flags = MAP_SHARED;
+#endif
+        void* mapping = mmap(nullptr, (size_t) status.st_size, PROT_READ, flags, descriptor, 0);
+        if (mapping != MAP_FAILED)
+        {
+            _mapping = mapping;
+            _mappingSize = (size_t) status.st_size;
+        }
+    }
+    // The mapping stays valid after the descriptor is closed.
+    close(descriptor);
+
+    if (_mapping != nullptr)
+        _values = table_values(_mapping, _mappingSize, _maxArgument);
+#endif
+}
+
+ZetaTable::~ZetaTable()
+{
+#if !defined(_WIN32)
+    if (_mapping != nullptr)
+        munmap(const_cast<void*>(_mapping), _mappingSize);
+#endif
+}
+
+bool ZetaTable::IsOpen() const
+{
+    return _values != nullptr;
+}
+
+int ZetaTable::GetMaxArgument() const
+{
+    return _maxArgument;
+}
+
+int ZetaTable::ReadArguments(double s, int first, span<double> values) const
+{
+    const int column = ColumnOf(s);
+    if (column < 0 || first < 1)
+        return 0;
+
+    const int count = max(0, min((int) values.size(), _maxArgument - first + 1));
+    const double* row = _values + (size_t) ExponentCount * _maxArgument + (size_t) column * _maxArgument;
+    copy(row + first - 1, row + first - 1 + count, values.begin());
+    return count;
+}
+
+bool use_zeta_table(const string& path)
+{
+    auto table = make_unique<ZetaTable>(path);
+    if (!table->IsOpen())
+    {
+        // Another process may be generating the same file, so the result only matters through the second open.
+        ZetaTable::Generate(path);
+        table = make_unique<ZetaTable>(path);
+    }
+    if (!table->IsOpen())
+        return false;
+
+    sharedTable = std::move(table);
+    return true;
+}
+
+const ZetaTable* shared_zeta_table()
+{
+    return sharedTable.get();
+}
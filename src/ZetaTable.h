@@ -0,0 +1,97 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * Precomputed values of the real Hurwitz zeta function zeta(s, a) on the standard exponent grid, s = 1.50, 1.51, ...,
+ * 3.51, and the integer arguments a = 1, ..., GetMaxArgument(). The table lives in a binary file that is mapped
+ * read-only, so processes fitting in parallel share a single copy through the page cache.
+ * The values for batches of exponents are evaluated with real_hurwitz_zeta_pairs and those for runs of arguments with
+ * real_hurwitz_zeta_range. A lookup returns what the library would have computed without the table when the vector
+ * kernels in use are those of the process that generated it. Otherwise it agrees to a few units in the last place:
+ * the scalar batch fallback shares its terms across exponents and differs from the table by less than 4e-15 relative,
+ * and the vector and scalar kernels differ by less than 1e-15.
+ */
+class ZetaTable
+{
+public:
+    static constexpr int GridDivisor = 100;
+    static constexpr int LowerIntExponent = 150;
+    static constexpr int ExponentCount = 202;
+    static constexpr int DefaultMaxArgument = 1024;
+
+private:
+    const void* _mapping = nullptr;
+    std::size_t _mappingSize = 0;
+    std::vector<double> _buffer;        // Contents of the file where it cannot be mapped
+    // One row of exponents per argument, for batches of exponents, followed by the same values with one row of
+    // arguments per exponent, for runs of arguments
+    const double* _values = nullptr;
+    int _maxArgument = 0;
+    double _exponents[ExponentCount];   // Exponent of every column, compared bit for bit in lookups
+
+public:
+    /**
+     * Writes a table file. It is written under a temporary name and renamed into place, so a process never maps a
+     * partially written table.
+     * @param path Path of the table file.
+     * @param maxArgument Largest tabulated argument.
+     * @return Whether the file was written.
+     */
+    static bool Generate(const std::string& path, int maxArgument = DefaultMaxArgument);
+
+    /// Maps the table file. The table is not open when the file is missing or has a different layout.
+    explicit ZetaTable(const std::string& path);
+    ~ZetaTable();
+
+    ZetaTable(const ZetaTable&) = delete;
+    ZetaTable& operator=(const ZetaTable&) = delete;
+
+    /// Whether the table file was mapped.
+    [[nodiscard]] bool IsOpen() const;
+
+    /// Largest tabulated argument.
+    [[nodiscard]] int GetMaxArgument() const;
+
+    /**
+     * Looks up zeta(s, a).
+     * @return Whether (s, a) is on the table grid, in which case value is set.
+     */
+    bool Find(double s, double a, double& value) const
+    {
+        const int column = ColumnOf(s);
+        if (column < 0 || !(a >= 1. && a <= _maxArgument) || static_cast<int>(a) != a)
+            return false;
+
+        value = _values[(std::size_t) (static_cast<int>(a) - 1) * ExponentCount + column];
+        return true;
+    }
+
+    /**
+     * Reads zeta(s, first + i) into values[i] for the leading arguments that are tabulated.
+     * @return Number of values read, zero when s is not on the grid.
+     */
+    int ReadArguments(double s, int first, std::span<double> values) const;
+
+private:
+    /// Column of an exponent on the grid, or -1 when it is not on it.
+    [[nodiscard]] int ColumnOf(double s) const
+    {
+        if (!(s > _exponents[0] - 0.5 / GridDivisor && s < _exponents[ExponentCount - 1] + 0.5 / GridDivisor))
+            return -1;
+        const int column = static_cast<int>(s * GridDivisor + 0.5) - LowerIntExponent;
+        return column < ExponentCount && _exponents[column] == s ? column : -1;
+    }
+};
+
+/**
+ * Makes the table file at path the table of the process, generating it first when it does not exist.
+ * Must be called before fitting starts.
+ * @return Whether the table could be opened.
+ */
+bool use_zeta_table(const std::string& path);
+
+/// Table of the process, or null when none is in use.
+const ZetaTable* shared_zeta_table();
@@ -0,0 +1,130 @@
+#include <string>
+#include <vector>
+#include "../include/DiscreteDistributions.h"
+#include "../src/BoundScanner.h"
+#include "../src/TailSummary.h"
+#include "TestUtilities.h"
+using namespace std;
+
+/// Tolerance of the comparisons between the scanners and the models, which evaluate the zeta function differently.
+constexpr double KSTolerance = 1e-12;
+
+string describe(unsigned int seed, double precision, AlphaEstimator estimator)
+{
+    const string estimatorName = (estimator == AlphaEstimator::Grid) ? "Grid" :
+                                 (estimator == AlphaEstimator::Brent) ? "Brent" : "Newton";
+    return "seed " + to_string(seed) + ", precision " + to_string(precision) + ", " + estimatorName;
+}
+
+/**
+ * The value that a pruned xMin candidate reports never exceeds the KS statistic of the model fitted at that xMin,
+ * and the pruned global search finds the smallest KS statistic of all the candidates.
+ */
+void test_pruned_lower_bound_scan(unsigned int seed, double precision, AlphaEstimator estimator)
+{
+    const vector<int> sample = generate_sample(seed, 2.5, 400);
+    const TailSummary summary(sample);
+    const vector<int>& values = summary.GetValues();
+    const string context = describe(seed, precision, estimator);
+
+    double minKsStatistic = numeric_limits<double>::infinity();
+    for (int i = 0; i + 1 < summary.GetDistinctSize(); ++i)
+    {
+        const DiscretePowerLawDistribution model(sample, values[i], precision, DistributionType::LeftBounded,
+                                                 estimator);
+        const double ksStatistic = model.GetKSStatistic();
+        minKsStatistic = min(minKsStatistic, ksStatistic);
+
+        for (const double ksThreshold : { 0.0, 0.5 * ksStatistic })
+        {
+            LowerBoundScanner scanner(summary, precision, estimator);
+            const BoundCandidate candidate = scanner.Evaluate(values[i], ksThreshold);
+            check(candidate.ksStatistic <= ksStatistic + KSTolerance,
+                  "pruned xMin " + to_string(values[i]) + " reports " + to_string(candidate.ksStatistic) +
+                  " above the fitted KS statistic " + to_string(ksStatistic) + ", " + context);
+        }
+    }
+
+    if (estimator == AlphaEstimator::Grid)
+    {
+        for (const RuntimeMode runtimeMode : { RuntimeMode::SingleThread, RuntimeMode::MultiThread })
+        {
+            const DiscretePowerLawDistribution model(sample, precision, DistributionType::LeftBounded, 20, estimator,
+                                                     runtimeMode, LowerBoundSearch::GlobalMinimum);
+            check(model.GetKSStatistic() <= minKsStatistic + KSTolerance,
+                  "pruned global search fits KS " + to_string(model.GetKSStatistic()) + " above the smallest " +
+                  to_string(minKsStatistic) + ", " + context);
+        }
+    }
+}
+
+/**
+ * The KS lower bound that prunes a candidate of the joint scan never exceeds the KS statistic of the doubly bounded
+ * model fitted with those bounds, and the pruned joint search finds the smallest KS statistic of all the candidates.
+ */
+void test_pruned_joint_bound_scan(unsigned int seed, double precision, AlphaEstimator estimator)
+{
+    constexpr int smallestInterval = 20;
+    const vector<int> sample = generate_sample(seed, 2.5, 300);
+    const TailSummary summary(sample);
+    const vector<int>& values = summary.GetValues();
+    const string context = describe(seed, precision, estimator);
+
+    // The bounds are only read from the table at the alpha levels. The grid table is needed to fit candidates in
+    // grid mode, so the scanner only evaluates whole candidates with the other estimators.
+    const DistinctValueZetaTable boundZetaTable(summary, JointBoundScanner::BoundAlphas(precision, estimator));
+    const DistinctValueZetaTable gridZetaTable(summary, vector<double>());
+
+    double minKsStatistic = numeric_limits<double>::infinity();
+    for (int first = 0; first < summary.GetDistinctSize(); ++first)
+    {
+        for (int last = first + 1; last < summary.GetDistinctSize(); ++last)
+        {
+            if (values[first] < 1 || values[last] < values[first] + smallestInterval)
+                continue;
+
+            const DiscretePowerLawDistribution model(sample, values[first], values[last], precision, estimator);
+            const double ksStatistic = model.GetKSStatistic();
+            minKsStatistic = min(minKsStatistic, ksStatistic);
+
+            JointBoundScanner scanner(summary, boundZetaTable, gridZetaTable, precision, estimator);
+            const double ksLowerBound = scanner.KSLowerBound(first, last, numeric_limits<double>::infinity());
+            check(ksLowerBound <= ksStatistic + KSTolerance,
+                  "bounds " + to_string(values[first]) + ", " + to_string(values[last]) + " have a KS lower bound " +
+                  to_string(ksLowerBound) + " above the fitted KS statistic " + to_string(ksStatistic) + ", " +
+                  context);
+
+            if (estimator != AlphaEstimator::Grid)
+            {
+                const BoundPairCandidate candidate = scanner.Evaluate(first, last, 0.0);
+                check(candidate.ksStatistic <= ksStatistic + KSTolerance,
+                      "pruned bounds " + to_string(values[first]) + ", " + to_string(values[last]) + " report " +
+                      to_string(candidate.ksStatistic) + " above the fitted KS statistic " + to_string(ksStatistic) +
+                      ", " + context);
+            }
+        }
+    }
+
+    if (estimator == AlphaEstimator::Grid)
+    {
+        const DiscretePowerLawDistribution model(sample, precision, DistributionType::DoublyBounded, smallestInterval,
+                                                 estimator, RuntimeMode::MultiThread);
+        check(model.GetKSStatistic() <= minKsStatistic + KSTolerance,
+              "pruned joint search fits KS " + to_string(model.GetKSStatistic()) + " above the smallest " +
+              to_string(minKsStatistic) + ", " + context);
+    }
+}
+
+int main()
+{
+    // Precision 0.003 does not divide the alpha limits, so its grid reaches past them.
+    for (const unsigned int seed : { 1u, 2u, 3u })
+        for (const double precision : { 0.01, 0.003 })
+            for (const AlphaEstimator estimator : { AlphaEstimator::Grid, AlphaEstimator::Brent, AlphaEstimator::Newton })
+            {
+                test_pruned_lower_bound_scan(seed, precision, estimator);
+                test_pruned_joint_bound_scan(seed, precision, estimator);
+            }
+
+    return test_result();
+}
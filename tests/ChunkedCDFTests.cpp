@@ -0,0 +1,84 @@
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/ChunkedCDF.h"
+#include "TestUtilities.h"
+using namespace std;
+
+constexpr int ChunkCount = 6;
+constexpr int XMax = ChunkCount * ChunkedCDF::ChunkLength;
+
+double inverse(int x)
+{
+    return 1.0 / x;
+}
+
+unique_ptr<ChunkedCDF> make_table()
+{
+    const auto fillChunk = [](int first, span<double> values)
+    {
+        for (size_t i = 0; i < values.size(); ++i)
+            values[i] = inverse(first + (int) i);
+    };
+    return make_unique<ChunkedCDF>(1, XMax, fillChunk, inverse);
+}
+
+/**
+ * Tables read concurrently never store more chunks together than the shared budget allows, the chunks past it are
+ * evaluated directly, and the budget is handed back when the tables are destroyed.
+ */
+void test_shared_budget()
+{
+    constexpr size_t chunkBytes = ChunkedCDF::ChunkLength * sizeof(double);
+    set_cdf_memory_budget(10 * chunkBytes);
+
+    vector<unique_ptr<ChunkedCDF>> tables;
+    for (int i = 0; i < 8; ++i)
+        tables.push_back(make_table());
+
+    vector<thread> readers;
+    vector<int> mismatches(tables.size(), 0);
+    for (size_t i = 0; i < tables.size(); ++i)
+    {
+        readers.emplace_back([&, i]
+        {
+            for (int x = XMax; x >= 1; --x)
+                mismatches[i] += tables[i]->Get(x) != inverse(x);
+        });
+    }
+    for (thread& reader : readers)
+        reader.join();
+
+    for (size_t i = 0; i < tables.size(); ++i)
+        check(mismatches[i] == 0, "table " + to_string(i) + " has " + to_string(mismatches[i]) + " wrong values");
+    check(cdf_memory_use() <= cdf_memory_budget(),
+          "the tables store " + to_string(cdf_memory_use()) + " bytes, past the budget of " +
+          to_string(cdf_memory_budget()));
+    check(cdf_memory_use() == 10 * chunkBytes, "the tables leave part of the budget unused");
+
+    tables.clear();
+    check(cdf_memory_use() == 0, "destroyed tables still hold " + to_string(cdf_memory_use()) + " bytes");
+    set_cdf_memory_budget(ChunkedCDF::DefaultMemoryBudget);
+}
+
+/// A table without any budget evaluates every value directly, the normalizer included.
+void test_empty_budget()
+{
+    set_cdf_memory_budget(0);
+    const unique_ptr<ChunkedCDF> table = make_table();
+    int mismatches = 0;
+    for (int x = 1; x <= XMax; ++x)
+        mismatches += table->Get(x) != inverse(x);
+    check(mismatches == 0, "the table without budget has " + to_string(mismatches) + " wrong values");
+    check(cdf_memory_use() == 0, "the table without budget stores " + to_string(cdf_memory_use()) + " bytes");
+    set_cdf_memory_budget(ChunkedCDF::DefaultMemoryBudget);
+}
+
+int main()
+{
+    test_shared_budget();
+    test_empty_budget();
+
+    return test_result();
+}
@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "../include/DiscreteDistributions.h"
+#include "TestUtilities.h"
+using namespace std;
+
+DiscretePowerLawDistribution fit(const vector<int>& sample, DistributionType distributionType, int minTailSize,
+                                 int smallestInterval = 20)
+{
+    return DiscretePowerLawDistribution(sample, 0.01, distributionType, smallestInterval, AlphaEstimator::Grid,
+                                        RuntimeMode::SingleThread, LowerBoundSearch::GlobalMinimum, minTailSize);
+}
+
+/// Tail-size floors outside [1, n] are rejected instead of being fitted.
+void test_floor_outside_sample_size()
+{
+    const vector<int> sample = generate_sample(1, 2.5, 382);
+    const int n = (int) sample.size();
+    for (const DistributionType distributionType : { DistributionType::LeftBounded, DistributionType::DoublyBounded })
+    {
+        for (const int minTailSize : { -5, 0, n + 1, 100000 })
+            check(fit(sample, distributionType, minTailSize).GetState() == DistributionState::InvalidInput,
+                  "minimum tail size " + to_string(minTailSize) + " is accepted");
+    }
+
+    // A floor of n leaves the smallest value as the only xMin candidate.
+    const DiscretePowerLawDistribution model = fit(sample, DistributionType::LeftBounded, n);
+    check(model.GetState() == DistributionState::Valid, "minimum tail size n is rejected");
+    check(model.GetXMin() == *min_element(sample.begin(), sample.end()),
+          "minimum tail size n fits xMin " + to_string(model.GetXMin()));
+}
+
+/// Fits with a valid floor keep at least that many observations in the fitted range.
+void test_floor_bounds_fitted_range()
+{
+    const vector<int> sample = generate_sample(2, 2.5, 382);
+    for (const int minTailSize : { 1, 50, 200 })
+    {
+        const DiscretePowerLawDistribution leftBounded = fit(sample, DistributionType::LeftBounded, minTailSize);
+        const auto tailSize = count_if(sample.begin(), sample.end(),
+                                       [&](int x) { return x >= leftBounded.GetXMin(); });
+        check(leftBounded.GetState() == DistributionState::Valid && tailSize >= minTailSize,
+              "xMin " + to_string(leftBounded.GetXMin()) + " has a tail of " + to_string(tailSize) +
+              " observations, below the minimum of " + to_string(minTailSize));
+
+        const DiscretePowerLawDistribution doublyBounded = fit(sample, DistributionType::DoublyBounded, minTailSize);
+        const auto rangeSize = count_if(sample.begin(), sample.end(), [&](int x)
+        {
+            return x >= doublyBounded.GetXMin() && x <= doublyBounded.GetXMax();
+        });
+        check(doublyBounded.GetState() == DistributionState::Valid && rangeSize >= minTailSize,
+              "bounds " + to_string(doublyBounded.GetXMin()) + ", " + to_string(doublyBounded.GetXMax()) +
+              " hold " + to_string(rangeSize) + " observations, below the minimum of " + to_string(minTailSize));
+    }
+}
+
+/// Samples without any bound candidate leave the model invalid instead of falling back to xMin = 1.
+void test_no_candidate()
+{
+    const vector<int> constantSample(50, 7);
+    check(fit(constantSample, DistributionType::LeftBounded, 1).GetState() == DistributionState::InvalidInput,
+          "a sample with one distinct value has an xMin");
+
+    const vector<int> narrowSample = { 3, 4, 4, 5, 6, 6, 6, 8, 9, 12 };
+    check(fit(narrowSample, DistributionType::DoublyBounded, 1, 20).GetState() == DistributionState::InvalidInput,
+          "a sample narrower than the smallest interval has bounds");
+}
+
+int main()
+{
+    test_floor_outside_sample_size();
+    test_floor_bounds_fitted_range();
+    test_no_candidate();
+
+    return test_result();
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/// Number of failed checks of the test program.
+inline int test_failures = 0;
+
+/// Reports the message when the condition does not hold.
+inline void check(bool condition, const std::string& message)
+{
+    if (!condition)
+    {
+        std::cout << "FAILED: " << message << std::endl;
+        test_failures++;
+    }
+}
+
+/// Exit code of the test program, after a summary of the checks.
+inline int test_result()
+{
+    if (test_failures > 0)
+    {
+        std::cout << test_failures << " checks failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}
+
+/// Uniform body below 10 and a power-law tail with exponent alpha above it, so xMin is not at the first value.
+inline std::vector<int> generate_sample(unsigned int seed, double alpha, int size)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<int> sample(size);
+    for (int& x : sample)
+    {
+        if (uniform(generator) < 0.3)
+            x = 1 + (int) (9.0 * uniform(generator));
+        else
+            x = (int) std::floor(9.5 * std::pow(1.0 - uniform(generator), -1.0 / (alpha - 1.0)) + 0.5);
+    }
+    return sample;
+}